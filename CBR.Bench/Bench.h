@@ -0,0 +1,67 @@
+#pragma once
+#include "Engine/Utility/Clock.h"
+#include "Engine/Memory/NoAllocTracking.h"
+#include <latch>
+
+// ϵͳ΢׼ÿ RunXxxBenchmark ѽӡ stdout
+// Ҫ͸ĶǰֱȽʱͬһ̨ͬһ
+namespace CBR::Bench
+{
+    void RunLogFormatBenchmark();
+    void RunMemoryLTBenchmark();
+    void RunQuarantineBenchmark();
+    void RunPoolAllocatorBenchmark();
+
+    // ĵʱӼʱ Timer/Profiler һ
+    class Stopwatch
+    {
+    public:
+        Stopwatch() noexcept : start_(Engine::Utility::Clock::Now()) {}
+
+        double ElapsedNanoseconds() const noexcept
+        {
+            return static_cast<double>(Engine::Utility::Clock::ToNanoseconds(Engine::Utility::Clock::Now() - start_));
+        }
+        double ElapsedMilliseconds() const noexcept { return ElapsedNanoseconds() * 1e-6; }
+
+    private:
+        uint64_t start_;
+    };
+
+    // ߳̾ȫ operator new ķ operator new ¶
+    inline uint64_t ThreadAllocationCount() noexcept
+    {
+        return Engine::Memory::noalloc::t_state.allocations;
+    }
+
+    // threadCount ߳ͬʱʼִ body()شӷеȫĺ̵߳ʱ䣩
+    template<typename Body>
+    double RunOnThreads(int threadCount, const Body& body)
+    {
+        std::latch start(threadCount + 1);
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&start, &body] {
+                start.arrive_and_wait();
+                body();
+            });
+        }
+
+        start.arrive_and_wait();
+        const Stopwatch stopwatch;
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        return stopwatch.ElapsedMilliseconds();
+    }
+
+    // ѽд volatile ֹĴ뱻Ż
+    inline void KeepAlive(uint64_t value) noexcept
+    {
+        static volatile uint64_t sink = 0;
+        sink = sink + value;
+    }
+} // namespace CBR::Bench
@@ -0,0 +1,126 @@
+#include "pch.h"
+#include "Bench.h"
+#include "Engine/Debug/Logger.h"
+
+namespace CBR::Bench
+{
+    using Engine::Debug::LogRecord;
+    using Engine::Debug::kLogRecordMessageSize;
+    using Engine::Debug::Logger;
+    using Engine::Debug::LogSite;
+
+    namespace
+    {
+        constexpr int kIterations = 200000;
+
+        // ĳ std::format ֮ǰ Logger ƴϢķʽд ostringstreamٿ¼
+        template<typename... Args>
+        std::string FormatLogMessage(Args&&... args)
+        {
+            std::ostringstream oss;
+            (oss << ... << args);
+            return oss.str();
+        }
+
+        void CopyToRecord(LogRecord& record, std::string_view message) noexcept
+        {
+            record.truncated = message.size() > kLogRecordMessageSize;
+            record.messageLength = static_cast<uint32_t>(std::min<std::size_t>(message.size(), kLogRecordMessageSize));
+            std::memcpy(record.message, message.data(), record.messageLength);
+        }
+
+        template<typename... Args>
+        void FormatToRecord(LogRecord& record, std::format_string<Args...> fmt, Args&&... args)
+        {
+            //  Logger::Log ͬ
+            const auto result = std::format_to_n(record.message, static_cast<std::ptrdiff_t>(kLogRecordMessageSize), fmt, std::forward<Args>(args)...);
+            record.truncated = result.size > static_cast<std::ptrdiff_t>(kLogRecordMessageSize);
+            record.messageLength = static_cast<uint32_t>(result.out - record.message);
+        }
+
+        // ֻ Logger  sink Ŀ Measure ļ¼κ I/O Logger ԼĿ
+        class CaptureSink : public Engine::Debug::ILogSink
+        {
+        public:
+            explicit CaptureSink(LogRecord*& target) noexcept : target_(target) {}
+
+            void Write(const LogRecord&, std::string_view header, std::string_view message) override
+            {
+                KeepAlive(header.size());
+                CopyToRecord(*target_, message);
+            }
+
+        private:
+            LogRecord*& target_;
+        };
+
+        // body(record, i) ʽһϢÿεõƽʱͶѷ
+        template<typename Body>
+        void Measure(const char* label, Body&& body)
+        {
+            LogRecord record;
+            for (int i = 0; i < kIterations / 10; ++i)
+            {
+                body(record, i);
+            }
+
+            const uint64_t allocationsBefore = ThreadAllocationCount();
+            const Stopwatch stopwatch;
+            for (int i = 0; i < kIterations; ++i)
+            {
+                body(record, i);
+                KeepAlive(record.messageLength);
+            }
+            const double nanoseconds = stopwatch.ElapsedNanoseconds();
+            const uint64_t allocations = ThreadAllocationCount() - allocationsBefore;
+
+            std::printf("  %-44s %8.1f ns/call %6.2f allocs/call  \"%.*s\"\n", label, nanoseconds / kIterations,
+                static_cast<double>(allocations) / kIterations, static_cast<int>(std::min<uint32_t>(record.messageLength, 48)), record.message);
+        }
+    }
+
+    void RunLogFormatBenchmark()
+    {
+        const std::string path = "Assets/Textures/Environment/terrain_albedo.dds";
+        const std::string longText(300, 'x');
+
+        Measure("int + double, format_to_n", [](LogRecord& record, int i) {
+            FormatToRecord(record, "Frame {} took {:.2f} ms", i, 16.6667 + (i & 7));
+        });
+        Measure("int + double, ostringstream", [](LogRecord& record, int i) {
+            CopyToRecord(record, FormatLogMessage("Frame ", i, " took ", std::fixed, std::setprecision(2), 16.6667 + (i & 7), " ms"));
+        });
+
+        Measure("string + int, format_to_n", [&path](LogRecord& record, int i) {
+            FormatToRecord(record, "Loaded '{}' ({} bytes)", path, i * 1024);
+        });
+        Measure("string + int, ostringstream", [&path](LogRecord& record, int i) {
+            CopyToRecord(record, FormatLogMessage("Loaded '", path, "' (", i * 1024, " bytes)"));
+        });
+
+        Measure("hex HRESULT, format_to_n", [](LogRecord& record, int i) {
+            FormatToRecord(record, "Present failed [HRESULT = 0x{:08X}]", static_cast<uint32_t>(0x887A0005u + i));
+        });
+        Measure("hex HRESULT, ostringstream", [](LogRecord& record, int i) {
+            CopyToRecord(record, FormatLogMessage("Present failed [HRESULT = 0x", std::hex, std::uppercase, std::setw(8), std::setfill('0'), static_cast<uint32_t>(0x887A0005u + i), "]"));
+        });
+
+        Measure("300-char string, format_to_n", [&longText](LogRecord& record, int i) {
+            FormatToRecord(record, "{} {}", longText, i);
+        });
+        Measure("300-char string, ostringstream", [&longText](LogRecord& record, int i) {
+            CopyToRecord(record, FormatLogMessage(longText, " ", i));
+        });
+
+        // ͬģʽStartAsync ֮ǰStopAsync ֮·ڵ߳ϣʽheaderʱ sink
+        LogRecord* target = nullptr;
+        Logger logger;
+        logger.ClearSinks();
+        logger.AddSink(std::make_unique<CaptureSink>(target));
+        static constinit LogSite site{ Engine::Debug::LogCategory::Engine, Engine::Debug::LogLevel::Value::Warn, std::source_location::current() };
+        Measure("Logger::Log, sync, capture sink", [&logger, &target](LogRecord& record, int i) {
+            target = &record;
+            logger.Log(site, "Frame {} took {:.2f} ms", i, 16.6667 + (i & 7));
+        });
+    }
+} // namespace CBR::Bench
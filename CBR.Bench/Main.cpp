@@ -0,0 +1,53 @@
+#include "pch.h"
+#include "Bench.h"
+
+// ÷: CBR.Bench [...]ʱȫС
+//  Release ãMemoryLT ֻ Debug ´ڣصĻ׼ Release »
+
+namespace
+{
+    struct Benchmark
+    {
+        const char* name;
+        const char* description;
+        void (*run)();
+    };
+
+    const Benchmark kBenchmarks[] = {
+        { "log_format", "std::format_to_n into a LogRecord vs the old ostringstream path", CBR::Bench::RunLogFormatBenchmark },
+        { "memorylt", "tracked new/delete throughput, one registry lock vs 16 shards (Debug)", CBR::Bench::RunMemoryLTBenchmark },
+        { "quarantine", "tracked new/delete with a 0 / 1 / 16 / 256 MB use-after-free quarantine (Debug)", CBR::Bench::RunQuarantineBenchmark },
+        { "pool", "frame-loop allocation pattern: PoolAllocate vs malloc (and HeapAlloc on Windows)", CBR::Bench::RunPoolAllocatorBenchmark },
+    };
+}
+
+int main(int argc, char** argv)
+{
+    int ran = 0;
+    for (const Benchmark& benchmark : kBenchmarks)
+    {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; ++i)
+        {
+            selected = std::strcmp(argv[i], benchmark.name) == 0;
+        }
+        if (!selected)
+            continue;
+
+        std::printf("== %s: %s\n", benchmark.name, benchmark.description);
+        benchmark.run();
+        std::printf("\n");
+        ++ran;
+    }
+
+    if (ran == 0)
+    {
+        std::fprintf(stderr, "Usage: CBR.Bench [name...]\nAvailable:\n");
+        for (const Benchmark& benchmark : kBenchmarks)
+        {
+            std::fprintf(stderr, "  %-16s %s\n", benchmark.name, benchmark.description);
+        }
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "Bench.h"
+#include "Engine/Debug/MemoryLT.h"
+
+namespace CBR::Bench
+{
+#if defined(_DEBUG)
+    namespace mlt = Engine::Debug::mlt;
+
+    namespace
+    {
+        constexpr int kOperationsPerThread = 200000;
+        // ÿ߳滻һСĿ飬delete ժͷ
+        constexpr int kLiveBlocksPerThread = 64;
+        constexpr int kThreadCounts[] = { 1, 2, 4, 8 };
+
+        void AllocationLoop()
+        {
+            char* blocks[kLiveBlocksPerThread] = {};
+            for (int i = 0; i < kOperationsPerThread; ++i)
+            {
+                char*& block = blocks[i % kLiveBlocksPerThread];
+                delete[] block;
+                block = new char[16 + ((i * 37) & 255)];
+                block[0] = static_cast<char>(i);
+            }
+            for (char* block : blocks)
+            {
+                delete[] block;
+            }
+        }
+
+        // ̺߳ϼÿٶ new/delete
+        double MeasureThroughput(int threadCount)
+        {
+            const double milliseconds = RunOnThreads(threadCount, AllocationLoop);
+            return static_cast<double>(threadCount) * kOperationsPerThread / (milliseconds * 1000.0);
+        }
+    }
+
+    void RunMemoryLTBenchmark()
+    {
+        std::printf("  %d tracked new[]/delete[] pairs per thread, 16-271 bytes, no guard bands, %u hardware threads\n",
+            kOperationsPerThread, std::thread::hardware_concurrency());
+
+        // 1 Ƭ = Ƭ֮ǰ߳ͬһѵǼ
+        for (const unsigned int shards : { 1u, 16u })
+        {
+            mlt::Config config;
+            config.registryShards = shards;
+            mlt::Init(config);
+
+            double singleThread = 0.0;
+            for (const int threadCount : kThreadCounts)
+            {
+                const double throughput = MeasureThroughput(threadCount);
+                if (threadCount == 1)
+                    singleThread = throughput;
+                std::printf("  %2u shard(s), %d thread(s): %7.2f Mops/s  (%.2fx of 1 thread)\n",
+                    shards, threadCount, throughput, throughput / singleThread);
+            }
+
+            mlt::Close();
+        }
+    }
+#else
+    void RunMemoryLTBenchmark()
+    {
+        std::printf("  MemoryLT only exists in Debug builds, skipped\n");
+    }
+#endif
+} // namespace CBR::Bench
@@ -0,0 +1,90 @@
+#include "pch.h"
+#include "Bench.h"
+#include "Engine/Memory/PoolAllocator.h"
+#include <random>
+
+namespace CBR::Bench
+{
+    namespace
+    {
+        constexpr int kThreads = 4;
+        constexpr int kFrames = 300;
+        constexpr int kTransientPerFrame = 3000;   // һ֡ǰȫͷ
+        constexpr int kPersistentPerFrame = 200;   // 滻֡Ŀ
+        constexpr std::size_t kPersistentSlots = 2000;
+        constexpr int kRepetitions = 3;
+
+        struct Allocator
+        {
+            const char* name;
+            void* (*allocate)(std::size_t size);
+            void (*free)(void* p);
+        };
+
+        const Allocator kAllocators[] = {
+            { "Memory::PoolAllocate", [](std::size_t size) { return Engine::Memory::PoolAllocate(size); }, [](void* p) { Engine::Memory::PoolFree(p); } },
+            { "malloc", [](std::size_t size) { return std::malloc(size); }, [](void* p) { std::free(p); } },
+#ifdef _WIN32
+            { "HeapAlloc(GetProcessHeap())", [](std::size_t size) { return HeapAlloc(GetProcessHeap(), 0, size); }, [](void* p) { HeapFree(GetProcessHeap(), 0, p); } },
+#endif
+        };
+
+        // ģһ֡ķ䣺󲿷 16-127 ֽڵʱ飬1/8  256 ֽڵ 4 KB滻һֿ֡Ŀ
+        void FrameLoop(const Allocator& allocator, unsigned int seed)
+        {
+            std::mt19937 random(seed);
+            std::vector<void*> transient;
+            transient.reserve(kTransientPerFrame);
+            std::vector<void*> persistent(kPersistentSlots, nullptr);
+
+            for (int frame = 0; frame < kFrames; ++frame)
+            {
+                for (int i = 0; i < kTransientPerFrame; ++i)
+                {
+                    const std::size_t size = (random() % 8 == 0) ? 256 + random() % 4096 : 16 + random() % 112;
+                    transient.push_back(allocator.allocate(size));
+                }
+                for (int i = 0; i < kPersistentPerFrame; ++i)
+                {
+                    void*& slot = persistent[random() % kPersistentSlots];
+                    if (slot)
+                        allocator.free(slot);
+                    slot = allocator.allocate(32 + random() % 1000);
+                }
+                for (void* p : transient)
+                {
+                    allocator.free(p);
+                }
+                transient.clear();
+            }
+
+            for (void* p : persistent)
+            {
+                if (p)
+                    allocator.free(p);
+            }
+        }
+    }
+
+    void RunPoolAllocatorBenchmark()
+    {
+        std::printf("  %d threads x %d frames, %d transient + %d persistent allocations per frame, best/worst of %d runs\n",
+            kThreads, kFrames, kTransientPerFrame, kPersistentPerFrame, kRepetitions);
+
+        for (const Allocator& allocator : kAllocators)
+        {
+            double best = std::numeric_limits<double>::max();
+            double worst = 0.0;
+            for (int repetition = 0; repetition < kRepetitions; ++repetition)
+            {
+                std::atomic<unsigned int> nextSeed{ 0 };
+                const double milliseconds = RunOnThreads(kThreads, [&allocator, &nextSeed] {
+                    FrameLoop(allocator, nextSeed.fetch_add(1, std::memory_order_relaxed));
+                });
+                best = std::min<double>(best, milliseconds);
+                worst = std::max<double>(worst, milliseconds);
+            }
+            std::printf("  %-28s %8.1f - %8.1f ms\n", allocator.name, best, worst);
+        }
+    }
+} // namespace CBR::Bench
@@ -0,0 +1,57 @@
+#include "pch.h"
+#include "Bench.h"
+#include "Engine/Debug/MemoryLT.h"
+
+namespace CBR::Bench
+{
+#if defined(_DEBUG)
+    namespace mlt = Engine::Debug::mlt;
+
+    namespace
+    {
+        constexpr int kThreads = 4;
+        constexpr int kOperationsPerThread = 200000;
+        constexpr std::size_t kQuarantineMegabytes[] = { 0, 1, 16, 256 };
+
+        void AllocationLoop()
+        {
+            for (int i = 0; i < kOperationsPerThread; ++i)
+            {
+                char* block = new char[16 + (i & 255)];
+                block[0] = static_cast<char>(i);
+                delete[] block;
+            }
+        }
+    }
+
+    void RunQuarantineBenchmark()
+    {
+        std::printf("  %d threads x %d tracked new[]/delete[] pairs, 16-271 bytes, guard bands on (same as DebugManager)\n",
+            kThreads, kOperationsPerThread);
+
+        double baseline = 0.0;
+        for (const std::size_t megabytes : kQuarantineMegabytes)
+        {
+            mlt::Config config;
+            config.heapCorruptionCheck = true;
+            config.buffer = 256;
+            config.quarantineBytes = megabytes << 20;
+            mlt::Init(config);
+
+            const double milliseconds = RunOnThreads(kThreads, AllocationLoop);
+            if (megabytes == 0)
+                baseline = milliseconds;
+            std::printf("  quarantine %3zu MB: %8.1f ms  %6.1f ns/pair  (%.2fx of no quarantine)\n", megabytes, milliseconds,
+                milliseconds * 1e6 / (static_cast<double>(kThreads) * kOperationsPerThread), milliseconds / baseline);
+
+            // Close ȰѸȫ鲢ͷţⲿֲʱ
+            mlt::Close();
+        }
+    }
+#else
+    void RunQuarantineBenchmark()
+    {
+        std::printf("  MemoryLT only exists in Debug builds, skipped\n");
+    }
+#endif
+} // namespace CBR::Bench
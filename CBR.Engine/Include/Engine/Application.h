@@ -11,6 +11,10 @@ namespace CBR::Engine
 	protected:
 		virtual bool Initialize() = 0;
 		virtual void Shotdowm() = 0;
+		// ̶ģ⣨Ϸ߼ÿִ֡ 0 ɴΣdt Ϊ Timer::FixedDeltaTime()
+		virtual void FixedUpdate(double fixedDeltaTime) { (void)fixedDeltaTime; }
+		// ÿȾ֡һΣ FixedUpdate ֮Ⱦ֮ǰalpha ΪȾֵ
+		virtual void Update(double deltaTime, double alpha) { (void)deltaTime; (void)alpha; }
 		static Application* GetInstance();
 		static void DestroyInstance(); // GameEngineShutdownShutdownٴݻʵ
 	public:
@@ -2,6 +2,13 @@
 
 namespace CBR::Engine::Utility {
     class Timer;
+    class FramePacer;
+    class Scheduler;
+}
+
+namespace CBR::Engine::Memory {
+    class FrameArena;
+    class DoubleBufferedFrameArena;
 }
 
 namespace CBR::Engine
@@ -10,13 +17,28 @@ namespace CBR::Engine
 	{
 		friend class WindowsMain;
 	public:
+		// ֡ʱݣÿ Iteration ʱ
+		static Memory::FrameArena& GetFrameArena();
+		// һ֡
+		static Memory::DoubleBufferedFrameArena& GetDoubleBufferedFrameArena();
+		// ֡ʱ͹̶ãSetFixedStepRate ȣ
+		static Utility::Timer& GetTimer();
+		// ֡ƣSetTargetFrameRate ȣ
+		static Utility::FramePacer& GetFramePacer();
+		// ʱصÿ֡ Timer::Tick ֮ƽ
+		static Utility::Scheduler& GetScheduler();
 	private:
 		static bool Initialize();
-		static bool Iteration();
+		// render Ϊ false ʱֻģⲻȾСʱ
+		static bool Iteration(bool render = true);
 		static void Shutdown();
 		static bool IsInitialized();
 
 		static std::unique_ptr<Utility::Timer> timer_;
+		static std::unique_ptr<Utility::FramePacer> framePacer_;
+		static std::unique_ptr<Utility::Scheduler> scheduler_;
+		static std::unique_ptr<Memory::FrameArena> frameArena_;
+		static std::unique_ptr<Memory::DoubleBufferedFrameArena> doubleBufferedFrameArena_;
 	};
 };
 
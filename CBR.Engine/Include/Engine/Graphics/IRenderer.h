@@ -12,7 +12,8 @@ namespace CBR::Engine::Graphics
 		virtual void BeginFrame() = 0;
 		virtual void EndFrame() = 0;
 
-		virtual void Render() = 0; // For Test
+		// alpha: һģⲽǰģⲽ֮Ĳֵ [0, 1)
+		virtual void Render(float alpha) = 0; // For Test
 	};
 };
 
@@ -0,0 +1,111 @@
+#pragma once
+
+namespace CBR::Engine::Memory
+{
+	class FrameArena;
+
+	//  std::pmr  FrameArena 䣺std::pmr::vector<int> v(arena.Resource());
+	// deallocate ʲôڴ Reset ʱһ
+	class FrameArenaResource final : public std::pmr::memory_resource
+	{
+	public:
+		explicit FrameArenaResource(FrameArena& arena) : arena_(arena) {}
+
+	private:
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+		void do_deallocate(void*, std::size_t, std::size_t) override {}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		FrameArena& arena_;
+	};
+
+	/// <summary>
+	///  ֡ʱõԷԤȷõĿ˳УReset ʱգܵͷš
+	///  ŲʱʱѶҪһ飬 Reset ʱͨ־Memory ࣩ棻֮飬һ֡Ͳ
+	///  ֻ߳ʹãĶ󲻻ᱻֻƽݻ pmr 
+	/// </summary>
+	class FrameArena
+	{
+	public:
+		explicit FrameArena(const char* name, std::size_t blockSize = 1024 * 1024, std::size_t blockCount = 1);
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+		FrameArena& operator= (const FrameArena&) = delete;
+
+		// ʧܣڴ治㣩 nullptralignment  2 
+		void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept;
+
+		template <typename T>
+		T* AllocateArray(std::size_t count) noexcept
+		{
+			static_assert(std::is_trivially_destructible_v<T>, "FrameArena never runs destructors");
+			if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+				return nullptr;
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		// һ֡з䣬 GameEngine::Iteration ֡ĩ
+		void Reset() noexcept;
+
+		std::pmr::memory_resource* Resource() noexcept { return &resource_; }
+
+		const char* Name() const { return name_; }
+		std::size_t BytesUsed() const { return usedBeforeCurrent_ + offset_; }
+		std::size_t Capacity() const { return capacity_; }
+		std::size_t HighWater() const { return highWater_; }
+		uint64_t OverflowCount() const { return overflowCount_; }
+
+	private:
+		struct Block
+		{
+			unsigned char* memory;
+			std::size_t size;
+		};
+
+		bool NextBlock() noexcept;
+
+		const char* name_;
+		std::size_t blockSize_;
+		std::vector<Block> blocks_;			// פĿ飬ʱ¼ӵĿҲ
+		std::vector<Block> oversized_;		//  blockSize_ ĵη䣬Reset ʱͷ
+		std::size_t current_ = 0;			// blocks_ õĿ
+		std::size_t offset_ = 0;			// ǰѾõֽ
+		std::size_t usedBeforeCurrent_ = 0;	// ǰõֽڣ oversized_
+		std::size_t capacity_ = 0;
+		std::size_t highWater_ = 0;
+		uint64_t overflowCount_ = 0;		// ۼ
+		bool overflowedThisFrame_ = false;
+		FrameArenaResource resource_{ *this };
+	};
+
+	/// <summary>
+	///   FrameArena ʹã N ֡ڵ N+1 ֡ǰЧ
+	///  Ҫһ֡ȡݣһ֡Ľ
+	/// </summary>
+	class DoubleBufferedFrameArena
+	{
+	public:
+		explicit DoubleBufferedFrameArena(const char* name, std::size_t blockSize = 1024 * 1024, std::size_t blockCount = 1)
+			: arenas_{ FrameArena(name, blockSize, blockCount), FrameArena(name, blockSize, blockCount) }
+		{
+		}
+
+		FrameArena& Current() { return arenas_[current_]; }
+		const FrameArena& Previous() const { return arenas_[current_ ^ 1]; }
+
+		void* Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) noexcept { return Current().Allocate(size, alignment); }
+		std::pmr::memory_resource* Resource() noexcept { return Current().Resource(); }
+
+		// ֡ĩã֡ݱգһ֡ݱһ֡
+		void Swap() noexcept
+		{
+			current_ ^= 1;
+			arenas_[current_].Reset();
+		}
+
+	private:
+		FrameArena arenas_[2];
+		std::size_t current_ = 0;
+	};
+} // namespace CBR::Engine::Memory
@@ -0,0 +1,66 @@
+#pragma once
+
+namespace CBR::Engine::Memory
+{
+	// ڴ水ϵͳͳơǩ Count ǰ棬 ToString
+	enum class MemoryTag : uint8_t
+	{
+		Untagged,
+		Engine,
+		Renderer,
+		Logger,
+		Game,
+		Assets,
+		Count
+	};
+
+	constexpr std::size_t kMemoryTagCount = static_cast<std::size_t>(MemoryTag::Count);
+
+	constexpr const char* ToString(MemoryTag tag)
+	{
+		switch (tag)
+		{
+		case MemoryTag::Untagged:	return "Untagged";
+		case MemoryTag::Engine:		return "Engine";
+		case MemoryTag::Renderer:	return "Renderer";
+		case MemoryTag::Logger:		return "Logger";
+		case MemoryTag::Game:		return "Game";
+		case MemoryTag::Assets:		return "Assets";
+		case MemoryTag::Count:		break;
+		}
+		return "Unknown";
+	}
+
+	/// <summary>
+	///  ̵߳жѷ䶼 tag £ͷʱǻطʱıǩǶףʱָıǩ
+	///  Memory::MemoryTagScope tag(Memory::MemoryTag::Renderer);
+	/// </summary>
+	class MemoryTagScope
+	{
+	public:
+		explicit MemoryTagScope(MemoryTag tag) noexcept;
+		~MemoryTagScope();
+
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator= (const MemoryTagScope&) = delete;
+
+	private:
+		MemoryTag previous_;
+	};
+
+	MemoryTag GetCurrentMemoryTag() noexcept;
+
+	// ԤʱWarn ֻ棬Assert  Debug »ᴥ
+	enum class MemoryBudgetAction : uint8_t
+	{
+		Warn,
+		Assert,
+	};
+
+	// bytes Ϊ 0 ʾûԤ㡣ÿ֡ʱһ
+	void SetMemoryBudget(MemoryTag tag, std::size_t bytes, MemoryBudgetAction action = MemoryBudgetAction::Warn) noexcept;
+	std::size_t GetMemoryBudget(MemoryTag tag) noexcept;
+
+	// ǩǰ̵ֽ߳ļڶȡʱźϲ߳ͬʱʱǽֵ
+	int64_t GetTaggedLiveBytes(MemoryTag tag) noexcept;
+} // namespace CBR::Engine::Memory
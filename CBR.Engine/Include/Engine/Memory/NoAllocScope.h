@@ -0,0 +1,64 @@
+#pragma once
+
+namespace CBR::Engine::Memory
+{
+	/// <summary>
+	///  ǲѷȶʱ֡ѭھȫ operator new ķᱻ
+	///  λûܲ棻ϸģʽ»ᴥԡǶףֻԵǰ߳Ч
+	///  ĬϹرգ SetNoAllocMode 򻷾 CBR_NOALLOC1=棬2=ϸ񣩴
+	/// </summary>
+	class NoAllocScope
+	{
+	public:
+		// active Ϊ false ʱʲô㰴Ԥ֡
+		explicit NoAllocScope(const char* name, bool active = true) noexcept;
+		~NoAllocScope();
+
+		NoAllocScope(const NoAllocScope&) = delete;
+		NoAllocScope& operator= (const NoAllocScope&) = delete;
+
+	private:
+		const char* previousName_;
+		bool active_;
+	};
+
+	/// <summary>
+	///   NoAllocScope ʱ䣬֪ҽܵķ䣨ֻڳʱߵ־
+	/// </summary>
+	class AllowAllocScope
+	{
+	public:
+		AllowAllocScope() noexcept;
+		~AllowAllocScope();
+
+		AllowAllocScope(const AllowAllocScope&) = delete;
+		AllowAllocScope& operator= (const AllowAllocScope&) = delete;
+
+	private:
+		int previousDepth_;
+	};
+
+	enum class NoAllocMode : uint8_t
+	{
+		Off,
+		Report,	// ÿµĵλõһγʱ
+		Strict,	// ͬϣ Debug ¶
+	};
+
+	void SetNoAllocMode(NoAllocMode mode) noexcept;
+	NoAllocMode GetNoAllocMode() noexcept;
+
+	// һ֡ķ GameEngine ֡ĩͳƣֻ̣߳
+	struct FrameAllocationMetrics
+	{
+		uint64_t frame = 0;
+		uint64_t allocations = 0;		// һ֡߳̾ operator new ķ
+		uint64_t bytes = 0;
+		uint64_t violations = 0;		// з NoAllocScope ģ̣߳
+		uint64_t violationBytes = 0;
+	};
+
+	FrameAllocationMetrics GetLastFrameAllocationMetrics() noexcept;
+	// ʼ NoAllocScope ķCI Ծݴжʧ
+	uint64_t GetNoAllocViolationCount() noexcept;
+} // namespace CBR::Engine::Memory
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace CBR::Engine::Utility
+{
+	enum class ClockSource : uint8_t
+	{
+		Platform,		// Windows: QueryPerformanceCounterƽ̨: clock_gettime(CLOCK_MONOTONIC_RAW)
+		Tsc,			// ֱӶ invariant TSCʱƽ̨ʱУ׼CPU ֧ʱ˻ Platform
+	};
+
+	/// <summary>
+	///  湲õĵ߾ʱӣTimer־ʱ֡ơܷ
+	///  Now() ԭʼ tickתԤõ /λ
+	///  ʱԴھ̬ʼʱ CBR_CLOCKplatform / tscѡ֮ٱ仯
+	/// </summary>
+	class Clock
+	{
+	public:
+		static uint64_t Now() noexcept;
+
+		static uint64_t ToNanoseconds(uint64_t ticks) noexcept;
+		static uint64_t FromNanoseconds(uint64_t nanoseconds) noexcept;
+		static double ToSeconds(uint64_t ticks) noexcept { return static_cast<double>(ToNanoseconds(ticks)) * 1e-9; }
+		static uint64_t NowNanoseconds() noexcept { return ToNanoseconds(Now()); }
+
+		// ÿٸ tickTSC ΪУ׼ֵ
+		static uint64_t Frequency() noexcept;
+		static ClockSource Source() noexcept;
+		static const char* SourceName() noexcept;
+
+		// ʼʱµ system_clock ׼Ͼĵʱ䣬־ʱ
+		// еϵͳʱ
+		static std::chrono::system_clock::time_point ToSystemTime(uint64_t ticks) noexcept;
+		static std::chrono::system_clock::time_point SystemNow() noexcept { return ToSystemTime(Now()); }
+	};
+};
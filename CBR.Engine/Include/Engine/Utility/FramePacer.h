@@ -0,0 +1,56 @@
+#pragma once
+
+namespace CBR::Engine::Utility
+{
+	struct FramePacerStats
+	{
+		uint64_t frames = 0;				//  WaitForNextFrame ֡
+		uint64_t missedDeadlines = 0;		// ʱѾֹʱ䣨̫֡ȴ
+		uint64_t sleepNanoseconds = 0;		// ϵͳ˯ȹʱ
+		uint64_t spinNanoseconds = 0;		// ʱ䣬ԽԽĵ
+		uint64_t oversleepCount = 0;		// ˯ʱѾ˽ֹʱĴ
+		uint64_t maxOversleepNanoseconds = 0;
+		uint64_t totalLatenessNanoseconds = 0;	// ʱԽֹʱ֮ͣ missed ֡
+		uint64_t maxLatenessNanoseconds = 0;
+	};
+
+	/// <summary>
+	///  ֡ƣĿ֡ųÿ֡Ľֹʱ䣬ø߾ȿɵȴʱWindows/ clock_nanosleep ˯ֹʱǰһ㣬
+	///  ֹʱ䣬һ 0.1ms ڡ۲쵽˯ԶӴSetSpinMargin ޡ
+	///  ĳһ֡ʱ׷ϣӵǰʱŽֹʱ
+	/// </summary>
+	class FramePacer
+	{
+	public:
+		FramePacer();
+		~FramePacer();
+
+		FramePacer(const FramePacer&) = delete;
+		FramePacer& operator= (const FramePacer&) = delete;
+
+		// 0 ʾ
+		void SetTargetFrameRate(double framesPerSecond);
+		double TargetFrameRate() const { return targetFrameRate_; }
+
+		// ֹʱǰԽԽ׼Խĵ磬0 ʾֻ˯
+		void SetSpinMargin(uint64_t nanoseconds) { spinMarginNs_ = nanoseconds; }
+		uint64_t SpinMargin() const { return spinMarginNs_; }
+
+		// ֡ĩãȵһ֡Ľֹʱ
+		void WaitForNextFrame();
+
+		const FramePacerStats& Stats() const { return stats_; }
+		void ResetStats() { stats_ = {}; }
+
+	private:
+		void SleepUntil(uint64_t deadlineTicks);
+
+		double targetFrameRate_ = 0.0;
+		uint64_t periodTicks_ = 0;
+		uint64_t nextDeadline_ = 0;			// 0 ʾûпʼ
+		uint64_t spinMarginNs_ = 200000;
+		uint64_t oversleepEstimateNs_ = 0;	// ˯˥
+		void* waitableTimer_ = nullptr;		// Windows  HANDLE
+		FramePacerStats stats_;
+	};
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+namespace CBR::Engine::Utility
+{
+	struct FrameTimeSummary
+	{
+		std::size_t frames = 0;		// ʵʲͳƵ֡Ĵڣ
+		double averageMs = 0.0;
+		double p50Ms = 0.0;
+		double p95Ms = 0.0;
+		double p99Ms = 0.0;
+		double maxMs = 0.0;
+	};
+
+	struct FrameHitch
+	{
+		uint64_t frame = 0;			// Timer::FrameIndex
+		double time = 0.0;			// Timer::RawTotalTime
+		double durationMs = 0.0;
+		double baselineMs = 0.0;	// ʱ֡ʱĻƽ
+	};
+
+	/// <summary>
+	///  ֡ʱͳƣ Timer::Tick ÿ֡д루ֻ߳дκ̶߳ȡ
+	///   kCapacity ֡Ļλ壨ٷλڼĶ̶ֱͼټ¼
+	///  ٣֡ʱͬʱ minimumMs  baselineFactor Ļƽ
+	///  д벻ڴ棬 NoAllocScope ʹ
+	/// </summary>
+	class FrameStats
+	{
+	public:
+		static constexpr std::size_t kCapacity = 8192;			// λ֡2
+		static constexpr std::size_t kMaxHitches = 1024;		// ֻô
+		static constexpr std::size_t kHistogramBuckets = 48;
+		static constexpr std::size_t kHistogramBucketsPerOctave = 4;
+		static constexpr double kHistogramBaseMs = 0.125;		// Ͱ 0  [0, base)Ͱ i  base * 2^((i-1)/4)
+
+		struct HitchConfig
+		{
+			double minimumMs = 20.0;
+			double baselineFactor = 2.0;
+		};
+
+		FrameStats() = default;
+		FrameStats(const FrameStats&) = delete;
+		FrameStats& operator= (const FrameStats&) = delete;
+
+		void Record(uint64_t frame, double time, double deltaSeconds) noexcept;
+		// һ֡ͳƣ細ڴСָĵһ֡
+		void IgnoreNextFrame() noexcept { ignoreNext_.store(true, std::memory_order_relaxed); }
+
+		void SetHitchConfig(const HitchConfig& config) noexcept { hitchConfig_ = config; }
+		const HitchConfig& GetHitchConfig() const noexcept { return hitchConfig_; }
+
+		//  windowFrames ֡İٷλ0 򳬹ʱ壩
+		FrameTimeSummary Summarize(std::size_t windowFrames) const noexcept;
+
+		uint64_t HistogramCount(std::size_t bucket) const noexcept;
+		static double HistogramBucketLowerMs(std::size_t bucket) noexcept;
+
+		// Ѿǵģ kMaxHitches 
+		uint64_t HitchCount() const noexcept { return hitchCount_.load(std::memory_order_acquire); }
+		std::vector<FrameHitch> Hitches() const;
+
+		// CSVÿ֡һУJSONڵİٷλֱͼͿ
+		bool WriteCsv(const char* path) const;
+		bool WriteJson(const char* path) const;
+
+	private:
+		struct Sample
+		{
+			std::atomic<uint64_t> frame{ 0 };
+			std::atomic<uint32_t> durationUs{ 0 };
+		};
+
+		// ֡ʱ䣬ʵʸƵĸĹбǵ֡ᱻ
+		std::size_t CopyRecent(std::size_t count, uint32_t* durations, uint64_t* frames) const noexcept;
+
+		Sample samples_[kCapacity];
+		std::atomic<uint64_t> head_{ 0 };
+		std::atomic<uint64_t> histogram_[kHistogramBuckets] = {};
+
+		struct HitchSlot
+		{
+			std::atomic<uint64_t> frame{ 0 };
+			std::atomic<double> time{ 0.0 };
+			std::atomic<double> durationMs{ 0.0 };
+			std::atomic<double> baselineMs{ 0.0 };
+		};
+		HitchSlot hitches_[kMaxHitches];
+		std::atomic<uint64_t> hitchCount_{ 0 };
+
+		HitchConfig hitchConfig_;
+		double baselineMs_ = 0.0;				// ֻд߳Ϸ
+		std::atomic<bool> ignoreNext_{ false };
+	};
+};
@@ -0,0 +1,121 @@
+#pragma once
+
+namespace CBR::Engine::Utility
+{
+	enum class TimeDomain : uint8_t
+	{
+		Game,	// Ϸʱ䣨Timer::DeltaTime TimeScale Ӱ죬ͣʱߣ
+		Real,	// ʵʱ䣨Timer::RawDeltaTime
+		Count
+	};
+
+	// ʱȡȻ԰ȫʹãIsPending  falseCancel ʲô
+	struct TimerHandle
+	{
+		uint64_t value = 0;
+
+		bool IsValid() const { return value != 0; }
+		explicit operator bool() const { return IsValid(); }
+		bool operator== (const TimerHandle&) const = default;
+	};
+
+	/// <summary>
+	///  ʱصȴӳ¼ÿʱһֲʱ֣4  x 256 ۣ 1msԼ 49 죬
+	///  Ӻȡ O(1)ƽʱֻʵڵĲۣɨȫʱ
+	///   GameEngine::Iteration  Timer::Tick ֮ƽһΣһ֡ڵĻص˳ִ߳У
+	///  صӻȡʱԼ̰߳ȫģֻ߳ʹ
+	/// </summary>
+	class Scheduler
+	{
+	public:
+		using Callback = std::function<void()>;
+
+		static constexpr double kResolutionSeconds = 0.001;
+
+		Scheduler();
+		~Scheduler();
+
+		Scheduler(const Scheduler&) = delete;
+		Scheduler& operator= (const Scheduler&) = delete;
+
+		// delaySeconds ִ֮һΣһ֡
+		TimerHandle Schedule(double delaySeconds, Callback callback, TimeDomain domain = TimeDomain::Game);
+		// ÿ intervalSeconds ִһΣһ intervalSeconds ֮һ֡ʱִֻһ
+		TimerHandle ScheduleRepeating(double intervalSeconds, Callback callback, TimeDomain domain = TimeDomain::Game);
+
+		// ûдظʱʱȡ true
+		bool Cancel(TimerHandle handle);
+		bool IsPending(TimerHandle handle) const;
+		// ´δڵȴʱظ
+		double TimeRemaining(TimerHandle handle) const;
+
+		void Advance(double realDeltaSeconds, double gameDeltaSeconds);
+
+		std::size_t PendingCount() const { return pendingCount_; }
+		// ȡжʱ
+		void Clear();
+
+	private:
+		static constexpr uint32_t kLevels = 4;
+		static constexpr uint32_t kSlotBits = 8;
+		static constexpr uint32_t kSlots = 1u << kSlotBits;
+		static constexpr uint32_t kNodesPerChunk = 4096;
+		static constexpr uint32_t kNil = UINT32_MAX;
+
+		enum class NodeState : uint8_t
+		{
+			Free,
+			Pending,	// ʱ
+			Expired,	// һ֡ڣȴִ
+			Running,	// صִ
+			Cancelled,	// صִбȡ
+		};
+
+		struct TimerNode
+		{
+			Callback callback;
+			uint64_t due = 0;			// ڵ tickʱֵľʱ䣬1 tick = 1ms
+			uint64_t interval = 0;		// ظڣtick0 Ϊһ
+			uint32_t prev = kNil;
+			uint32_t next = kNil;		// Ҳ
+			uint32_t generation = 1;
+			uint16_t slot = 0;			// level * kSlots + slot
+			TimeDomain domain = TimeDomain::Game;
+			NodeState state = NodeState::Free;
+		};
+
+		struct Wheel
+		{
+			uint64_t currentTick = 0;	// Ѿ tick
+			uint64_t elapsedNanoseconds = 0;
+			uint32_t heads[kLevels * kSlots];
+			uint64_t occupied[kLevels][kSlots / 64] = {};
+		};
+
+		struct ExpiredTimer
+		{
+			uint32_t index;
+			uint32_t generation;
+		};
+
+		TimerHandle Add(uint64_t delayTicks, uint64_t intervalTicks, Callback&& callback, TimeDomain domain);
+		TimerNode* Resolve(TimerHandle handle) const;
+		TimerNode& Node(uint32_t index) const { return chunks_[index / kNodesPerChunk][index % kNodesPerChunk]; }
+		uint32_t AllocateNode();
+		void FreeNode(uint32_t index);
+
+		void Link(Wheel& wheel, uint32_t index);
+		void Unlink(Wheel& wheel, uint32_t index);
+		uint32_t DetachSlot(Wheel& wheel, uint32_t level, uint32_t slot);
+		void AdvanceWheel(Wheel& wheel, uint64_t targetTick);
+		void RunExpired();
+
+		std::vector<std::unique_ptr<TimerNode[]>> chunks_;
+		uint32_t nodeCount_ = 0;
+		uint32_t freeList_ = kNil;
+		std::size_t pendingCount_ = 0;
+		Wheel wheels_[static_cast<std::size_t>(TimeDomain::Count)];
+		std::vector<ExpiredTimer> expired_;		// ãÿ֡
+		bool advancing_ = false;
+	};
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include "Engine/Utility/FrameStats.h"
 
 namespace CBR::Engine::Utility
 {
@@ -11,7 +12,11 @@ namespace CBR::Engine::Utility
 		Timer(const Timer&) = delete;
 		Timer& operator= (const Timer&) = delete;
 
+		// ÿ֡һΣ֡Ϸʱۻ̶ۼ
 		void Tick();
+		// ѭͣСʱϢ֮ãͣסʱ䲻һ֡
+		//  DeltaTime ʱ䣬Update ϷʱĶʱᵱϷһֱ
+		void Resume();
 
 		double RawDeltaTime() const { return rawDeltaTime_; }
 		double DeltaTime() const { return deltaTime_; }
@@ -22,13 +27,32 @@ namespace CBR::Engine::Utility
 		void SetTimeScale(double s) { timeScale_ = s; }
 		double TimeScale() const { return timeScale_; }
 
+		// ̶ģ⣺һ֡Ҫִм FixedUpdateÿƽ FixedDeltaTime()
+		void SetFixedStepRate(double stepsPerSecond);
+		double FixedStepRate() const { return 1.0 / fixedDeltaTime_; }
+		double FixedDeltaTime() const { return fixedDeltaTime_; }
+		uint32_t FixedStepCount() const { return fixedStepCount_; }
+		uint64_t FixedStepIndex() const { return fixedStepIndex_; }
+		// ۼʣµĲһʱռһı [0, 1)Ⱦʱһ͵ǰֵ֮
+		double InterpolationAlpha() const { return timeLag_ / fixedDeltaTime_; }
+
+		// ٺ׷ϼʱֱӶԽ׷Խѭ
+		void SetMaxFixedStepsPerFrame(uint32_t steps) { maxFixedStepsPerFrame_ = steps ? steps : 1; }
+		uint32_t MaxFixedStepsPerFrame() const { return maxFixedStepsPerFrame_; }
+		// ģʱܺͣ룩Ϊ 0 ˵ģ
+		double DroppedTime() const { return droppedTime_; }
+
+		// ÿ֡ʵ֡ʱ䣨RawDeltaTimeͳ
+		FrameStats& GetFrameStats() { return frameStats_; }
+		const FrameStats& GetFrameStats() const { return frameStats_; }
+
 	private:
-		// QPC
-		int64_t engineStartCounter_ = 0;
-		int64_t lastFrameCounter_ = 0;
-		int64_t frequency_ = 0;				// ÿٸQPC tick
+		// Clock tick
+		uint64_t engineStartCounter_ = 0;
+		uint64_t lastFrameCounter_ = 0;
 
-		static constexpr double FIXED_DELTA_TIME = 1.0 / 60.0;
+		static constexpr double DEFAULT_FIXED_DELTA_TIME = 1.0 / 60.0;
+		static constexpr double MAX_FRAME_DELTA_TIME = 0.25;	// ϵ㡢϶֮ĳ֡ʱ
 		double rawDeltaTime_ = 0.0;
 		double deltaTime_ = 0.0;
 		double rawTotalTime_ = 0.0;			// ʵۼʱ
@@ -36,7 +60,14 @@ namespace CBR::Engine::Utility
 		double timeScale_ = 1.0;
 		
 		uint64_t frameIndex_ = 0;
-		double timeLag = 0;
+
+		double fixedDeltaTime_ = DEFAULT_FIXED_DELTA_TIME;
+		double timeLag_ = 0.0;				// ûб̶ĵϷʱ
+		double droppedTime_ = 0.0;
+		uint32_t fixedStepCount_ = 0;
+		uint32_t maxFixedStepsPerFrame_ = 8;
+		uint64_t fixedStepIndex_ = 0;
+
+		FrameStats frameStats_;
 	};
 };
-
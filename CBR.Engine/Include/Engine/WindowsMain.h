@@ -13,6 +13,35 @@ namespace CBR::Engine
 		// ڣʼȴڣMainֱӵ
 		static int Run(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _In_ LPWSTR lpCmdLine, _In_ int nCmdShow);
 
+		// ڲǰ̨ʱѭΪ
+		struct BackgroundPolicy
+		{
+			double unfocusedFrameRate = 15.0;	// ʧȥʱ֡ޣ0 ʾǰ̨һ
+			double hiddenTickRate = 0.0;		// С/ʱģ⣨ȾƵʣ0 ʾͣȴϢϷʱҲͣס
+		};
+
+		enum class LoopMode : uint8_t
+		{
+			Foreground,
+			Unfocused,
+			Hidden,		// СػڵС
+			Count
+		};
+
+		// ģʽ¾ʱ䡢 CPU ʱִе֡CPU ռ = cpuSeconds / wallSeconds
+		// ǰģʽʱлģʽ˳ѭʱż
+		struct MainLoopStats
+		{
+			double wallSeconds[static_cast<std::size_t>(LoopMode::Count)] = {};
+			double cpuSeconds[static_cast<std::size_t>(LoopMode::Count)] = {};
+			uint64_t iterations[static_cast<std::size_t>(LoopMode::Count)] = {};
+		};
+
+		// Ĭֵ CBR_UNFOCUSED_FPSCBR_HIDDEN_TICK_RATE 
+		static void SetBackgroundPolicy(const BackgroundPolicy& policy);
+		static const BackgroundPolicy& GetBackgroundPolicy();
+		static MainLoopStats GetMainLoopStats();
+
 		static HWND GetMainWindowHandle();
 		static RECT GetDefaultWindowRect();
 		static uint32_t GetDefaultScreenWidth();
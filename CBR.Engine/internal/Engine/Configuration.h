@@ -4,4 +4,19 @@
 #define CBR_USE_DEBUG_MANAGER 1
 #else
 #define CBR_USE_DEBUG_MANAGER 0
-#endif
\ No newline at end of file
+#endif
+
+// ȫ operator new / delete ʹ Memory::PoolAllocate0 ʱֱ malloc/free
+#ifndef CBR_USE_POOL_ALLOCATOR
+#define CBR_USE_POOL_ALLOCATOR 1
+#endif
+
+// ѷ䰴 Memory::MemoryTag ͳƴֽڲԤ㣨ÿ 16 ֽڣ
+#ifndef CBR_ENABLE_MEMORY_TAGS
+#define CBR_ENABLE_MEMORY_TAGS 1
+#endif
+
+// CBR_PROFILE_SCOPE ׮Ϊ 0 ʱչΪգΪ 1 ʱû Profiler::Start ҲֻһԭӶ
+#ifndef CBR_ENABLE_PROFILER
+#define CBR_ENABLE_PROFILER 1
+#endif
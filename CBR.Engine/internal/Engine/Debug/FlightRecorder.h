@@ -0,0 +1,92 @@
+#pragma once
+#include "Engine/Debug/LogBinaryFormat.h"
+
+namespace CBR::Engine::Debug
+{
+    struct LogSite;
+
+    constexpr std::size_t kFlightRecordPayloadSize = 208; //  FlightRecord  256 ֽ
+
+    // м¼һ¼ LogBinary 룬ıʽ
+    struct FlightRecord
+    {
+        std::atomic<uint64_t> stamp{ 0 }; // дΪ 0дΪ д+1dump ʱдһļ¼
+        const LogSite* site = nullptr;
+        const char* format = nullptr;     // õĸʽַ
+        int64_t timestamp = 0;            // ns since epoch
+        uint32_t threadId = 0;            // ring ᱻ̸߳ãÿ¼Լ߳id
+        uint16_t sequence = 0;
+        uint16_t formatLength = 0;
+        uint16_t payloadLength = 0;
+        char payload[kFlightRecordPayloadSize];
+    };
+    static_assert(sizeof(FlightRecord) == 256);
+
+    /// <summary>
+    ///  ʱķм¼ÿ߳ԼĶλֻɱ߳д룬¼ N ־
+    ///   sink ˵ DEBUG¼ʱڴ棬̵ֻ߳һμ¼ʱһλ
+    ///  źŻδ쳣ʱ̵߳ļ¼ʱ˳дɶ־ CBR.LogDecoder 鿴
+    /// </summary>
+    class FlightRecorder
+    {
+    public:
+        static constexpr std::size_t kDefaultRecordsPerThread = 256;
+
+        // recordsPerThread ֻڵһ Enable ʱЧȡ2ݣcaptureMask Ҫ¼ļ
+        static void Enable(std::size_t recordsPerThread, const std::filesystem::path& dumpPath, uint32_t captureMask);
+        static void Disable();
+        static bool IsEnabled() noexcept { return s_enabled.load(std::memory_order_relaxed); }
+
+        // ע SetUnhandledExceptionFilter / ź  std::terminate Ĵ
+        static void InstallCrashHandlers();
+
+        // ̵߳ļ¼д dumpPathдļ¼ֻʹԤ׼õľ̬ڱе
+        static std::size_t Dump() noexcept;
+
+        template<typename... Args>
+        static void Record(const LogSite& site, std::string_view format, uint16_t sequence, std::chrono::system_clock::time_point timestamp, const Args&... args)
+        {
+            ThreadRing* ring = t_ring ? t_ring : AcquireRing();
+            if (!ring)
+                return;
+
+            // ֻб߳д ringhead Ҫ RMW
+            const uint64_t index = ring->head.load(std::memory_order_relaxed);
+            FlightRecord& record = ring->records[index & ring->mask];
+
+            record.stamp.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            record.site = &site;
+            record.format = format.data();
+            record.formatLength = static_cast<uint16_t>(std::min<std::size_t>(format.size(), UINT16_MAX));
+            record.threadId = ring->threadId;
+            record.sequence = sequence;
+            record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+
+            LogBinary::ArgWriter writer(record.payload, kFlightRecordPayloadSize);
+            (writer.Put(args), ...);
+            record.payloadLength = static_cast<uint16_t>(writer.Size());
+
+            record.stamp.store(index + 1, std::memory_order_release);
+            ring->head.store(index + 1, std::memory_order_release);
+        }
+
+    private:
+        struct ThreadRing
+        {
+            ThreadRing* next = nullptr;
+            FlightRecord* records = nullptr;
+            std::size_t mask = 0;
+            uint32_t threadId = 0;
+            std::atomic<bool> inUse{ false };   // ߳˳Ա̸߳
+            std::atomic<uint64_t> head{ 0 };    // дļ¼
+        };
+
+        static ThreadRing* AcquireRing();
+
+        static inline std::atomic<bool> s_enabled{ false };
+        static inline std::atomic<ThreadRing*> s_rings{ nullptr }; // ֻ̽ǰͷţʱҲܰȫ
+        static inline thread_local ThreadRing* t_ring = nullptr;
+    };
+} // namespace CBR::Engine::Debug
@@ -0,0 +1,294 @@
+#pragma once
+// ־ļʽ棨д룩 CBR.LogDecoder룩ͷļԼ
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace CBR::Engine::Debug::LogBinary
+{
+    // ļṹFileHeader֮ chunkֽСˣд
+    //   SiteDefinition: [type u8][id u32][level u8][line u32][fileLen u16][funcLen u16][formatLen u16][file][func][format]
+    //   Event:          [type u8][siteId u32][sequence u16][timestamp i64 (ns since epoch)][payloadLen u16][payload]
+    //   Thread:         [type u8][threadId u32]֮ Event ̣߳м¼ dump У
+    //   Message:        [type u8][level u8][sequence u16][timestamp i64][line u32][fileLen u16][funcLen u16][textLen u16][file][func][text]
+    //                   Ѿʽáûеõļ¼ظ/ʾLogger::Info ȣfileLen Ϊ 0 ʾûλ
+    // payload ǲУÿΪ [ArgType u8][]ʱõ std::format ʽַԭ
+    constexpr char kMagic[8] = { 'C', 'B', 'R', 'B', 'L', 'O', 'G', '\0' };
+    constexpr uint32_t kVersion = 4;
+
+    struct FileHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    enum class ChunkType : uint8_t
+    {
+        SiteDefinition = 1,
+        Event = 2,
+        Thread = 3,
+        Message = 4,
+    };
+
+    enum class ArgType : uint8_t
+    {
+        Int64 = 1,
+        UInt64,
+        Double,
+        Bool,
+        Char,
+        Pointer,
+        String,     // [len u16][bytes]
+    };
+
+    /// <summary>
+    ///  Ѳԭд÷ṩĶռ䲻ʱĲ Truncated
+    /// </summary>
+    class ArgWriter
+    {
+    public:
+        ArgWriter(char* buffer, std::size_t capacity) noexcept : buffer_(buffer), capacity_(capacity) {}
+
+        template<typename T>
+        void Put(const T& value)
+        {
+            using D = std::remove_cvref_t<T>;
+            if constexpr (std::is_same_v<D, bool>)
+                PutScalar(ArgType::Bool, static_cast<uint8_t>(value));
+            else if constexpr (std::is_same_v<D, char>)
+                PutScalar(ArgType::Char, value);
+            else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>)
+                PutScalar(ArgType::Int64, static_cast<int64_t>(value));
+            else if constexpr (std::is_integral_v<D>)
+                PutScalar(ArgType::UInt64, static_cast<uint64_t>(value));
+            else if constexpr (std::is_floating_point_v<D>)
+                PutScalar(ArgType::Double, static_cast<double>(value));
+            else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>)
+                PutString(value ? std::string_view(value) : std::string_view("(null)"));
+            else if constexpr (std::is_convertible_v<const D&, std::string_view>)
+                PutString(std::string_view(value));
+            else if constexpr (std::is_pointer_v<D>)
+                PutScalar(ArgType::Pointer, reinterpret_cast<uint64_t>(value));
+            else
+            {
+                // ͣԶ std::formatterûжƱʾջϸʽıڴ档
+                //  kFallbackTextSize ĲֶĲճд
+                char text[kFallbackTextSize];
+                const auto result = std::format_to_n(text, static_cast<std::ptrdiff_t>(sizeof(text)), "{}", value);
+                PutString(std::string_view(text, static_cast<std::size_t>(result.out - text)));
+            }
+        }
+
+        std::size_t Size() const noexcept { return size_; }
+        bool Truncated() const noexcept { return truncated_; }
+
+    private:
+        static constexpr std::size_t kFallbackTextSize = 256;
+
+        template<typename T>
+        void PutScalar(ArgType type, T value) noexcept
+        {
+            if (truncated_ || size_ + 1 + sizeof(T) > capacity_)
+            {
+                truncated_ = true;
+                return;
+            }
+            buffer_[size_++] = static_cast<char>(type);
+            std::memcpy(buffer_ + size_, &value, sizeof(T));
+            size_ += sizeof(T);
+        }
+
+        void PutString(std::string_view s) noexcept
+        {
+            if (truncated_ || size_ + 1 + sizeof(uint16_t) > capacity_)
+            {
+                truncated_ = true;
+                return;
+            }
+            const std::size_t room = capacity_ - size_ - 1 - sizeof(uint16_t);
+            if (s.size() > room)
+            {
+                s = s.substr(0, room);
+                truncated_ = true;
+            }
+            const uint16_t len = static_cast<uint16_t>(s.size());
+            buffer_[size_++] = static_cast<char>(ArgType::String);
+            std::memcpy(buffer_ + size_, &len, sizeof(len));
+            size_ += sizeof(len);
+            std::memcpy(buffer_ + size_, s.data(), s.size());
+            size_ += s.size();
+        }
+
+        char* buffer_;
+        std::size_t capacity_;
+        std::size_t size_ = 0;
+        bool truncated_ = false;
+    };
+
+    struct ArgValue
+    {
+        ArgType type = ArgType::Int64;
+        union
+        {
+            int64_t i;
+            uint64_t u;
+            double d;
+            bool b;
+            char c;
+        };
+        std::string_view s;
+    };
+
+    /// <summary>
+    ///  ˳ ArgWriter дĲֱַ payload
+    /// </summary>
+    class ArgReader
+    {
+    public:
+        ArgReader(const char* data, std::size_t size) noexcept : cur_(data), end_(data + size) {}
+
+        bool Next(ArgValue& out) noexcept
+        {
+            if (cur_ >= end_)
+                return false;
+
+            out.type = static_cast<ArgType>(*cur_++);
+            switch (out.type)
+            {
+            case ArgType::Int64:   return Read(out.i);
+            case ArgType::UInt64:  return Read(out.u);
+            case ArgType::Double:  return Read(out.d);
+            case ArgType::Pointer: return Read(out.u);
+            case ArgType::Char:    return Read(out.c);
+            case ArgType::Bool:
+            {
+                uint8_t v = 0;
+                if (!Read(v)) return false;
+                out.b = v != 0;
+                return true;
+            }
+            case ArgType::String:
+            {
+                uint16_t len = 0;
+                if (!Read(len) || end_ - cur_ < len) return false;
+                out.s = std::string_view(cur_, len);
+                cur_ += len;
+                return true;
+            }
+            }
+            return false;
+        }
+
+    private:
+        template<typename T>
+        bool Read(T& value) noexcept
+        {
+            if (end_ - cur_ < static_cast<std::ptrdiff_t>(sizeof(T)))
+                return false;
+            std::memcpy(&value, cur_, sizeof(T));
+            cur_ += sizeof(T);
+            return true;
+        }
+
+        const char* cur_;
+        const char* end_;
+    };
+
+    // 滻ĸʽ˵'{:' ֮Ĳ֣һ׷ӳı
+    inline void AppendArgText(std::string& out, const ArgValue& arg, std::string_view spec)
+    {
+        std::string field = "{:";
+        field += spec;
+        field += '}';
+
+        try
+        {
+            switch (arg.type)
+            {
+            case ArgType::Int64:   { int64_t v = arg.i; out += std::vformat(field, std::make_format_args(v)); } break;
+            case ArgType::UInt64:  { uint64_t v = arg.u; out += std::vformat(field, std::make_format_args(v)); } break;
+            case ArgType::Double:  { double v = arg.d; out += std::vformat(field, std::make_format_args(v)); } break;
+            case ArgType::Bool:    { bool v = arg.b; out += std::vformat(field, std::make_format_args(v)); } break;
+            case ArgType::Char:    { char v = arg.c; out += std::vformat(field, std::make_format_args(v)); } break;
+            case ArgType::String:  { std::string_view v = arg.s; out += std::vformat(field, std::make_format_args(v)); } break;
+            case ArgType::Pointer:
+            {
+                const void* v = reinterpret_cast<const void*>(static_cast<uintptr_t>(arg.u));
+                out += std::vformat(field, std::make_format_args(v));
+            } break;
+            }
+        }
+        catch (const std::format_error&)
+        {
+            // ˻ıĲֵַܴ֧ĸʽ˵
+            out += "{?}";
+        }
+    }
+
+    // õõĸʽַ payload ԭϢıֻ֧ std::format 滻﷨ڼ飨Ѿˣ
+    inline std::string FormatPayload(std::string_view format, const char* payload, std::size_t size)
+    {
+        std::vector<ArgValue> args;
+        ArgReader reader(payload, size);
+        ArgValue arg{};
+        while (reader.Next(arg))
+        {
+            args.push_back(arg);
+        }
+
+        std::string text;
+        std::size_t nextArg = 0;
+        for (std::size_t i = 0; i < format.size(); ++i)
+        {
+            const char c = format[i];
+            if (c == '{')
+            {
+                if (i + 1 < format.size() && format[i + 1] == '{')
+                {
+                    text += '{';
+                    ++i;
+                    continue;
+                }
+
+                const std::size_t close = format.find('}', i);
+                if (close == std::string_view::npos)
+                    break;
+
+                const std::string_view field = format.substr(i + 1, close - i - 1);
+                const std::size_t colon = field.find(':');
+                const std::string_view index = field.substr(0, colon);
+                const std::string_view spec = (colon == std::string_view::npos) ? std::string_view() : field.substr(colon + 1);
+
+                std::size_t argIndex = nextArg++;
+                if (!index.empty())
+                {
+                    argIndex = 0;
+                    for (const char d : index)
+                        argIndex = argIndex * 10 + static_cast<std::size_t>(d - '0');
+                }
+
+                if (argIndex < args.size())
+                    AppendArgText(text, args[argIndex], spec);
+                else
+                    text += "{?}"; // ض϶ʧ
+
+                i = close;
+            }
+            else if (c == '}' && i + 1 < format.size() && format[i + 1] == '}')
+            {
+                text += '}';
+                ++i;
+            }
+            else
+            {
+                text += c;
+            }
+        }
+        return text;
+    }
+} // namespace CBR::Engine::Debug::LogBinary
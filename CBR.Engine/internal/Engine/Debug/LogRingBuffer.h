@@ -0,0 +1,100 @@
+#pragma once
+
+namespace CBR::Engine::Debug
+{
+    /// <summary>
+    ///  нζУVyukov MPMCLOG̣߳Loggerд̣߳
+    ///  DropOldestҲӣ˶̴߳ȡ2ݡ
+    /// </summary>
+    template<typename T>
+    class LogRingBuffer
+    {
+    public:
+        explicit LogRingBuffer(std::size_t capacity)
+            : mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1)
+            , cells_(std::make_unique<Cell[]>(mask_ + 1))
+        {
+            for (std::size_t i = 0; i <= mask_; ++i)
+            {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        LogRingBuffer(const LogRingBuffer&) = delete;
+        LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+        bool TryPush(const T& value) noexcept
+        {
+            std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells_[pos & mask_];
+                const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+                const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.data = value;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // 
+                }
+                else
+                {
+                    pos = enqueuePos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool TryPop(T& out) noexcept
+        {
+            std::size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells_[pos & mask_];
+                const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+                const std::intptr_t diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        out = cell.data;
+                        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false; // յ
+                }
+                else
+                {
+                    pos = dequeuePos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        std::size_t Capacity() const noexcept { return mask_ + 1; }
+
+    private:
+        static constexpr std::size_t kCacheLineSize = 64;
+
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence{ 0 };
+            T data{};
+        };
+
+        const std::size_t mask_;
+        std::unique_ptr<Cell[]> cells_;
+
+        // ߺߵαڲͬcache lineϣfalse sharing
+        alignas(kCacheLineSize) std::atomic<std::size_t> enqueuePos_{ 0 };
+        alignas(kCacheLineSize) std::atomic<std::size_t> dequeuePos_{ 0 };
+    };
+} // namespace CBR::Engine::Debug
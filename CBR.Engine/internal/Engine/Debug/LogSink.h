@@ -0,0 +1,107 @@
+#pragma once
+
+namespace CBR::Engine::Debug
+{
+    struct LogRecord;
+
+    /// <summary>
+    ///  Logger ˡLogger ڳԼʱ˳ø sinksink Ҫ
+    ///  header  "[#seq] [timestamp] [LEVEL] [file:line | func]"message Ǹʽõģֱ record.message
+    ///  record.truncated ʱıضϹsink Լں "..."
+    /// </summary>
+    class ILogSink
+    {
+    public:
+        virtual ~ILogSink() = default;
+
+        virtual void Write(const LogRecord& record, std::string_view header, std::string_view message) = 0;
+        virtual void Flush() {}
+    };
+
+    /// <summary>
+    ///  ̨Windows  WriteConsoleW ͬƽ̨ ANSI ɫд stdout
+    ///  ڿ
+    /// </summary>
+    class ConsoleLogSink : public ILogSink
+    {
+    public:
+        explicit ConsoleLogSink(bool openDebugConsole);
+        ~ConsoleLogSink() override;
+
+        void Write(const LogRecord& record, std::string_view header, std::string_view message) override;
+        void Flush() override;
+
+    private:
+#ifdef _WIN32
+        void OpenDebugConsole();
+        static std::wstring AnsiToUtf16(std::string_view s);
+
+        HANDLE hConsole_ = nullptr;
+        WORD   defaultAttr_ = 0;
+        bool   ownsConsole_ = false;
+#endif
+    };
+
+    /// <summary>
+    ///  ͨ׷дļ ofstream Ļ
+    /// </summary>
+    class FileLogSink : public ILogSink
+    {
+    public:
+        explicit FileLogSink(const std::filesystem::path& path, bool append = true);
+
+        bool IsOpen() const noexcept { return file_.is_open(); }
+
+        void Write(const LogRecord& record, std::string_view header, std::string_view message) override;
+        void Flush() override;
+
+    private:
+        std::ofstream file_;
+    };
+
+    struct MappedLogConfig
+    {
+        std::filesystem::path basePath = "cbr";           // ļΪ <basePath>_<index>.logindex ļ
+        std::size_t segmentSize = 16 * 1024 * 1024;        // ÿֶԤֽ
+        std::chrono::seconds rollInterval{ 0 };             // 0 ʾֻСл
+        uint32_t maxSegments = 8;                          // ķֶ0 ʾɾɷֶ
+    };
+
+    /// <summary>
+    ///  ڴӳĹ־ļÿֶڴʱԤ䲢ӳ䣬дֻ memcpy
+    ///  ûϵͳãд򳬹ʱʱضϵʵʳȲлһֶ
+    /// </summary>
+    class MappedRotatingFileSink : public ILogSink
+    {
+    public:
+        explicit MappedRotatingFileSink(const MappedLogConfig& config);
+        ~MappedRotatingFileSink() override;
+
+        MappedRotatingFileSink(const MappedRotatingFileSink&) = delete;
+        MappedRotatingFileSink& operator=(const MappedRotatingFileSink&) = delete;
+
+        bool IsOpen() const noexcept { return view_ != nullptr; }
+
+        void Write(const LogRecord& record, std::string_view header, std::string_view message) override;
+        void Flush() override;
+
+    private:
+        void ContinueNumbering();
+        bool OpenSegment(std::chrono::system_clock::time_point now);
+        void CloseSegment();
+        void Append(std::string_view text) noexcept;
+        std::filesystem::path SegmentPath(uint32_t index) const;
+
+        MappedLogConfig config_;
+        uint32_t segmentIndex_ = 0;
+        std::chrono::system_clock::time_point segmentStart_{};
+        char* view_ = nullptr;
+        std::size_t offset_ = 0;
+#ifdef _WIN32
+        HANDLE file_ = INVALID_HANDLE_VALUE;
+        HANDLE mapping_ = nullptr;
+#else
+        int fd_ = -1;
+#endif
+    };
+} // namespace CBR::Engine::Debug
@@ -1,9 +1,16 @@
 #pragma once
+#include "Engine/Debug/LogRingBuffer.h"
+#include "Engine/Debug/LogBinaryFormat.h"
+#include "Engine/Debug/LogSink.h"
+#include "Engine/Debug/FlightRecorder.h"
+#include "Engine/Utility/Clock.h"
 
 namespace CBR::Engine::Debug
 {
     constexpr int kConsoleWindowWidth = 120;
     constexpr int kConsoleWindowHeight = 31;
+    constexpr std::size_t kLogRecordMessageSize = 448; // 첽ģʽµϢֽֽض
+    constexpr std::size_t kLogHeaderSize = 512;        // WriteRecord ջϸʽ header Ļر𳤵ĺǩᱻض
 
     struct LogLevel
     {
@@ -27,6 +34,7 @@ namespace CBR::Engine::Debug
             return "UNKNOWN";
         }
     
+#ifdef _WIN32
         WORD ToColor() const noexcept {
             switch (value) {
             case Value::Info:  return FOREGROUND_GREEN | FOREGROUND_INTENSITY;
@@ -37,8 +45,153 @@ namespace CBR::Engine::Debug
         
             return FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE;
         }
+#endif // _WIN32
     };
     
+    // ־࣬ÿжʱ
+    enum class LogCategory : uint8_t
+    {
+        Engine,
+        Renderer,
+        Memory,
+        Game,
+        Count
+    };
+
+    constexpr std::string_view ToString(LogCategory category) noexcept
+    {
+        switch (category) {
+        case LogCategory::Engine:   return "Engine";
+        case LogCategory::Renderer: return "Renderer";
+        case LogCategory::Memory:   return "Memory";
+        case LogCategory::Game:     return "Game";
+        case LogCategory::Count:    break;
+        }
+        return "Unknown";
+    }
+
+    /// <summary>
+    ///  ļˡLOGֵκβ֮ǰȼرյ־ֻһ atomic load һη֧
+    ///  û CBR_LOG_LEVELS ļCBR_LOG_CONFIGĬ cbr_log.cfgãʽ
+    ///    Renderer=Warn, Memory=Debug, *=Info, Game=Off
+    ///  ֵDebug < Info < Warn < Error־
+    /// </summary>
+    class LogFilter
+    {
+    public:
+        static constexpr uint32_t LevelBit(LogLevel::Value level) noexcept { return 1u << static_cast<uint32_t>(level); }
+        static constexpr uint32_t kAllLevels = 0xF;
+#if defined(_DEBUG)
+        static constexpr uint32_t kDefaultMask = kAllLevels;
+#else
+        static constexpr uint32_t kDefaultMask = (1u << 1) | (1u << 2); // Release Ĭֻ Warn  Error
+#endif
+
+        // LOGãsink м¼һҪ¼ʱΪ true
+        static bool IsEnabled(LogCategory category, LogLevel::Value level) noexcept
+        {
+            return (s_masks[static_cast<std::size_t>(category)].load(std::memory_order_relaxed) & LevelBit(level)) != 0;
+        }
+
+        // Ƿ sink̨ļ־
+        static bool IsSinkEnabled(LogCategory category, LogLevel::Value level) noexcept
+        {
+            return (s_sinkMasks[static_cast<std::size_t>(category)].load(std::memory_order_relaxed) & LevelBit(level)) != 0;
+        }
+
+        // м¼Ҫļ𣬶зЧ sink ϲж
+        static void SetCaptureMask(uint32_t mask) noexcept;
+
+        static void SetMask(LogCategory category, uint32_t mask) noexcept;
+        static void SetMinimumLevel(LogCategory category, LogLevel::Value level) noexcept;
+        static void SetMinimumLevelAll(LogLevel::Value level) noexcept;
+        static uint32_t GetMask(LogCategory category) noexcept;
+
+        //  "Category=Level" бšֺŻзָ޷ʶĿ
+        static int Configure(std::string_view spec);
+        // ȶļû
+        static void LoadConfiguration();
+
+    private:
+        static void UpdateMask(std::size_t index) noexcept;
+
+        static inline std::atomic<uint32_t> s_masks[static_cast<std::size_t>(LogCategory::Count)] = {
+            kDefaultMask, kDefaultMask, kDefaultMask, kDefaultMask
+        };
+        static inline std::atomic<uint32_t> s_sinkMasks[static_cast<std::size_t>(LogCategory::Count)] = {
+            kDefaultMask, kDefaultMask, kDefaultMask, kDefaultMask
+        };
+        static inline std::atomic<uint32_t> s_captureMask{ 0 };
+    };
+
+    // 첽ʱĴʽ
+    enum class LogOverflowPolicy
+    {
+        Block,      // ߵȴд߳ڳռ䣬Ϣ
+        DropNewest, // ǰ
+        DropOldest, // ɵһٷ뵱ǰ
+    };
+
+    struct AsyncLogConfig
+    {
+        std::size_t capacity = 4096;
+        LogOverflowPolicy overflowPolicy = LogOverflowPolicy::Block;
+    };
+
+    // õƷʽ CBR_LOG_LIMITED / CBR_LOG_DEDUP ָڸʽ֮ǰж
+    struct LogSuppression
+    {
+        uint32_t maxPerSecond = 0; // ÿ0 ʾ
+        bool dedup = false;        // ȫͬϢֻһ֮ظ
+    };
+
+    /// <summary>
+    ///  ÿLOGõһľ̬ɺ constinit 壬Ҫʼ
+    ///  ģʽֻڵһǰļʱѵõϢдȥ֮ļ¼ֻ binaryId
+    /// </summary>
+    struct LogSite
+    {
+        LogCategory category;
+        LogLevel::Value level;
+        std::source_location location;
+        LogSuppression suppression{};
+        uint32_t binaryId = 0;    //  binaryEpoch Ӧļidֻڳ Logger  mutex_ ʱ
+        uint32_t binaryEpoch = 0; //  Logger ǰĲͬʱ binaryId Чûдļ0 ʾûд
+
+        // ״̬߳ǽƵģᶪڱ߽ܶŹһ
+        std::atomic<int64_t> windowStart{ 0 };      // ڵ㣨ns
+        std::atomic<uint32_t> windowCount{ 0 };
+        std::atomic<uint32_t> suppressed{ 0 };      // û
+        std::atomic<uint64_t> lastHash{ 0 };        // һϢĹϣ
+        std::atomic<uint32_t> repeats{ 0 };         // һͬû
+        std::atomic<int64_t> repeatReportedAt{ 0 }; // ظʱÿ뱨һ
+        std::atomic<bool> registered{ false };      // Ƿѹҵ Logger Ĵ
+        LogSite* nextSuppressed = nullptr;
+    };
+
+    /// <summary>
+    ///  ̶С־¼ڵ߳ɣд̸߳ʽ
+    ///  file/func ָֻ룬ָ̬洢std::source_location ṩַһ㣩
+    /// </summary>
+    struct LogRecord
+    {
+        LogLevel::Value level = LogLevel::Value::Info;
+        uint16_t sequence = 0;
+        int line = 0;
+        std::chrono::system_clock::time_point timestamp{};
+        const char* file = nullptr;
+        uint32_t fileLength = 0;
+        const char* func = nullptr;
+        uint32_t funcLength = 0;
+        const char* format = nullptr;   // ģʽµĸʽַдõ㶨ʱ
+        uint32_t formatLength = 0;
+        uint32_t messageLength = 0;
+        bool truncated = false;
+        bool binary = false;            // true ʱ message δʽĲLogBinary 룩site Ч
+        LogSite* site = nullptr;
+        char message[kLogRecordMessageSize];
+    };
+
     class Logger
     {
     public:
@@ -48,64 +201,247 @@ namespace CBR::Engine::Debug
         Logger(const Logger&) = delete; // ֹ
         Logger& operator=(const Logger&) = delete; // ֹһѾڵ WindowsMain ֵͨһ WindowsMain ״̬
 
+        // std::format 񣬸ʽַڱڼ顣ϢֱӸʽջϵ LogRecordڴ
         template<typename... Args>
-        void InfoMsg(const std::source_location loc, Args&&... args)
-        { Info(FormatLogMessage(std::forward<Args>(args)...), loc.file_name(), static_cast<int>(loc.line()), ShortFunctionName(loc.function_name())); }
-    
-        template<typename... Args>
-        void WarnMsg(const std::source_location loc, Args&&... args) 
-        { Warn(FormatLogMessage(std::forward<Args>(args)...), loc.file_name(), static_cast<int>(loc.line()), ShortFunctionName(loc.function_name())); }
-    
-        template<typename... Args>
-        void ErrorMsg(const std::source_location loc, Args&&... args) 
-        { Error(FormatLogMessage(std::forward<Args>(args)...), loc.file_name(), static_cast<int>(loc.line()), ShortFunctionName(loc.function_name())); }
-    
-        template<typename... Args>
-        void DebugMsg(const std::source_location loc, Args&&... args) 
-        { Debug(FormatLogMessage(std::forward<Args>(args)...), loc.file_name(), static_cast<int>(loc.line()), ShortFunctionName(loc.function_name())); }
+        void Log(LogSite& site, std::format_string<Args...> fmt, Args&&... args)
+        {
+            LogRecord record;
+            record.level = site.level;
+            record.timestamp = Utility::Clock::SystemNow();
+
+            if ((site.suppression.maxPerSecond != 0 || site.suppression.dedup) && IsSuppressed(site, record.timestamp, args...))
+                return;
+
+            record.sequence = ++s_logSequence;
+
+            // м¼ȼһݣsink ܲҪ Release µ DEBUG
+            if (FlightRecorder::IsEnabled())
+                FlightRecorder::Record(site, fmt.get(), record.sequence, record.timestamp, args...);
+
+            if (!LogFilter::IsSinkEnabled(site.category, site.level))
+                return;
+
+            if (ProducerScope producer(producers_); binary_.load(std::memory_order_seq_cst))
+            {
+                // ģʽκıʽֻԭʼֽ
+                const std::string_view format = fmt.get();
+                record.binary = true;
+                record.site = &site;
+                record.format = format.data();
+                record.formatLength = static_cast<uint32_t>(format.size());
+
+                LogBinary::ArgWriter writer(record.message, kLogRecordMessageSize);
+                (writer.Put(args), ...);
+                record.messageLength = static_cast<uint32_t>(writer.Size());
+                record.truncated = writer.Truncated();
+
+                Enqueue(record);
+                return;
+            }
+
+            const std::string_view file = site.location.file_name();
+            const std::string_view func = ShortFunctionName(site.location.function_name());
+            record.line = static_cast<int>(site.location.line());
+            record.file = file.data();
+            record.fileLength = static_cast<uint32_t>(file.size());
+            record.func = func.data();
+            record.funcLength = static_cast<uint32_t>(func.size());
+
+            const auto result = std::format_to_n(record.message, static_cast<std::ptrdiff_t>(kLogRecordMessageSize), fmt, std::forward<Args>(args)...);
+            record.truncated = result.size > static_cast<std::ptrdiff_t>(kLogRecordMessageSize);
+            record.messageLength = static_cast<uint32_t>(result.out - record.message);
+
+            Submit(record);
+        }
     
         void Info(std::string_view message, std::string_view file, int line, std::string_view func);
         void Warn(std::string_view message, std::string_view file, int line, std::string_view func);
         void Error(std::string_view message, std::string_view file, int line, std::string_view func);
         void Debug(std::string_view message, std::string_view file, int line, std::string_view func);
 
+        // 첽ģʽֻ߳Ѽ¼ŽУʽкͿ̨I/Oд߳
+        void StartAsync(const AsyncLogConfig& config = {});
+        void StopAsync(); // Flushд̣֮߳صͬģʽ
+        void Flush();     // ȴǰӵļ¼ȫ
+        bool IsAsync() const noexcept { return async_.load(std::memory_order_acquire); }
+
+        // ģʽLOGļ¼ֻдļҪStartAsync CBR.LogDecoder ԭı
+        bool OpenBinaryLog(const std::filesystem::path& path);
+        void CloseBinaryLog();
+        uint64_t DroppedCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+        // ˡĬֻп̨CBR_LOG_FILE=<path> ׷ıļCBR_LOG_MAPPED=<base> дڴӳĹļ
+        void AddSink(std::unique_ptr<ILogSink> sink);
+        void ClearSinks();
+        void ConfigureSinksFromEnvironment();
+
+        // "void __cdecl Foo::Bar(int)" -> "Foo::Bar(int)"ָԭַ
+        static std::string_view ShortFunctionName(std::string_view sig);
+
     private:
         static std::atomic<uint16_t> s_logSequence;
-        static std::wstring AnsiToUtf16(std::string_view s);
-        static std::string_view ShortFunctionName(std::string_view sig);
 
-        void OpenDebugConsole(); // ĿǰLoggerڹconsoleΪĿǰֻconsoleϢ
-        void Write(const LogLevel& level, std::string_view message, std::string_view file, int line, std::string_view func);
-        std::string GetTimestamp() const;
-        std::string ExtractFilename(std::string_view filepath) const;
+        static uint64_t HashBytes(const char* data, std::size_t size) noexcept
+        {
+            // FNV-1a
+            uint64_t hash = 14695981039346656037ull;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+        // ȥءֻòĶƱȽϣƵϢᱻʽ
         template<typename... Args>
-        std::string FormatLogMessage(Args&&... args)
+        bool IsSuppressed(LogSite& site, std::chrono::system_clock::time_point now, const Args&... args)
         {
-            std::ostringstream oss;
-            (oss << ... << args);
-            return oss.str();
+            constexpr int64_t kSecond = 1000000000;
+            const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+
+            if (site.suppression.dedup)
+            {
+                char buffer[kLogRecordMessageSize];
+                LogBinary::ArgWriter writer(buffer, sizeof(buffer));
+                (writer.Put(args), ...);
+                const uint64_t hash = HashBytes(buffer, writer.Size()) | 1; // 0 ûһ
+
+                if (site.lastHash.exchange(hash, std::memory_order_relaxed) == hash)
+                {
+                    site.repeats.fetch_add(1, std::memory_order_relaxed);
+                    RegisterSuppressedSite(site);
+
+                    // һֱظϢÿ뱨һδȫ
+                    int64_t reportedAt = site.repeatReportedAt.load(std::memory_order_relaxed);
+                    if (nowNs - reportedAt >= kSecond && site.repeatReportedAt.compare_exchange_strong(reportedAt, nowNs, std::memory_order_relaxed))
+                        ReportSuppressed(site);
+                    return true;
+                }
+
+                // һͬϢȲһظ
+                site.repeatReportedAt.store(nowNs, std::memory_order_relaxed);
+                ReportSuppressed(site);
+            }
+
+            if (site.suppression.maxPerSecond != 0)
+            {
+                int64_t start = site.windowStart.load(std::memory_order_relaxed);
+                if (nowNs - start >= kSecond && site.windowStart.compare_exchange_strong(start, nowNs, std::memory_order_relaxed))
+                {
+                    site.windowCount.store(0, std::memory_order_relaxed);
+                    ReportSuppressed(site);
+                }
+
+                if (site.windowCount.fetch_add(1, std::memory_order_relaxed) >= site.suppression.maxPerSecond)
+                {
+                    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+                    RegisterSuppressedSite(site);
+                    return true;
+                }
+            }
+            return false;
         }
+
+        void RegisterSuppressedSite(LogSite& site) noexcept;
+        void ReportSuppressed(LogSite& site);  // õ㻹ûظͱ
+
+        // ڼ async_/binary_ ֮ǰǼǣ뿪 Enqueue ע
+        // StopAsync ȼͣд̡߳ͷŶУ߻ͷŵĶУ Block ԶȲλ
+        class ProducerScope
+        {
+        public:
+            explicit ProducerScope(std::atomic<uint32_t>& count) noexcept
+                : count_(count)
+            {
+                count_.fetch_add(1, std::memory_order_seq_cst);
+            }
+            ~ProducerScope() { count_.fetch_sub(1, std::memory_order_release); }
+
+            ProducerScope(const ProducerScope&) = delete;
+            ProducerScope& operator=(const ProducerScope&) = delete;
+
+        private:
+            std::atomic<uint32_t>& count_;
+        };
+
+        void Write(const LogLevel& level, std::string_view message, std::string_view file, int line, std::string_view func);
+        void Submit(const LogRecord& record);
+        void Enqueue(const LogRecord& record);
+        void WriteRecord(const LogRecord& record);
+        void WriteBinaryRecord(const LogRecord& record);  // ûд򿪶ļʱʲô
+        void WriterThreadMain();
+        static std::size_t FormatTimestamp(std::chrono::system_clock::time_point time, char* buffer, std::size_t size); // "HH:MM:SS.mmm"س
+        std::string ExtractFilename(std::string_view filepath) const;
     
-#ifdef _WIN32
-        HANDLE hConsole_ = nullptr;
-        WORD   defaultAttr_ = 0;
-        bool   ownsConsole_ = false;
-#endif
         std::mutex mutex_;
+        std::vector<std::unique_ptr<ILogSink>> sinks_; // ֻڳ mutex_ ʱ
+
+        // 첽ģʽ
+        std::unique_ptr<LogRingBuffer<LogRecord>> queue_;
+        std::thread writerThread_;
+        LogOverflowPolicy overflowPolicy_ = LogOverflowPolicy::Block;
+        std::atomic<bool> async_{ false };
+        std::atomic<bool> stopWriter_{ false };
+        std::atomic<uint32_t> producers_{ 0 };    //  ProducerScope
+        std::atomic<uint32_t> wakeSignal_{ 0 };   // д߳ߣӺ
+        std::atomic<uint64_t> enqueued_{ 0 };
+        std::atomic<uint64_t> processed_{ 0 };     // DropOldestļ¼FlushжϽ
+        std::atomic<uint64_t> dropped_{ 0 };
+        uint64_t reportedDropped_ = 0;            // ֻд߳Ϸ
+
+        // йϢĵõ㣨ֻFlush ʱϻûĴ
+        std::atomic<LogSite*> suppressedSites_{ nullptr };
+
+        // ģʽ
+        std::atomic<bool> binary_{ false };
+        std::ofstream binaryFile_;
+        uint32_t nextBinarySiteId_ = 1;
+        uint32_t binaryEpoch_ = 0;  // ÿ OpenBinaryLog һõ㿿ж϶ǲѾдǰļ
     };
 
     //  DebugManager ʵ֣ںʵǰȫ Logger
     Logger& GetLogger() noexcept;
     
-#if defined(_DEBUG)
-    #define LOG_INFO(...)  CBR::Engine::Debug::GetLogger().InfoMsg(std::source_location::current(), __VA_ARGS__)
-    #define LOG_WARN(...)  CBR::Engine::Debug::GetLogger().WarnMsg(std::source_location::current(), __VA_ARGS__)
-    #define LOG_ERROR(...) CBR::Engine::Debug::GetLogger().ErrorMsg(std::source_location::current(), __VA_ARGS__)
-    #define LOG_DEBUG(...) CBR::Engine::Debug::GetLogger().DebugMsg(std::source_location::current(), __VA_ARGS__)
-#else
-    #define LOG_INFO(...) 
-    #define LOG_WARN(...) 
-    #define LOG_ERROR(...)
-    #define LOG_DEBUG(...)
-#endif
+    // ÿõһ̬ LogSite¼ࡢ source_location
+    // ȼرʱᱻֵRelease ͬЧĬֻ Warn/Error
+    #define CBR_LOG_SITE_AT(category, level, suppression, ...) \
+        do { \
+            if (CBR::Engine::Debug::LogFilter::IsEnabled(category, level)) { \
+                static constinit CBR::Engine::Debug::LogSite cbrLogSite_{ category, level, std::source_location::current(), suppression }; \
+                CBR::Engine::Debug::GetLogger().Log(cbrLogSite_, __VA_ARGS__); \
+            } \
+        } while (0)
+
+    #define CBR_LOG_AT(category, level, ...) \
+        CBR_LOG_SITE_AT(category, level, CBR::Engine::Debug::LogSuppression{}, __VA_ARGS__)
+
+    // CBR_LOG(Renderer, Error, "Present failed [HRESULT = 0x{:08X}]", hr);
+    #define CBR_LOG(category, level, ...) \
+        CBR_LOG_AT(CBR::Engine::Debug::LogCategory::category, CBR::Engine::Debug::LogLevel::Value::level, __VA_ARGS__)
+
+    // ÿ֡ߵĵطCBR_LOG_LIMITED(Renderer, Warn, 5, "Slow frame {} ms", ms);
+    // ÿ perSecond ֻһڿʼʱ
+    #define CBR_LOG_LIMITED(category, level, perSecond, ...) \
+        CBR_LOG_SITE_AT(CBR::Engine::Debug::LogCategory::category, CBR::Engine::Debug::LogLevel::Value::level, \
+            (CBR::Engine::Debug::LogSuppression{ .maxPerSecond = (perSecond) }), __VA_ARGS__)
+
+    // ͬϢϲһ "repeated N times"
+    #define CBR_LOG_DEDUP(category, level, ...) \
+        CBR_LOG_SITE_AT(CBR::Engine::Debug::LogCategory::category, CBR::Engine::Debug::LogLevel::Value::level, \
+            (CBR::Engine::Debug::LogSuppression{ .dedup = true }), __VA_ARGS__)
+
+    #define LOG_INFO(...)  CBR_LOG(Engine, Info, __VA_ARGS__)
+    #define LOG_WARN(...)  CBR_LOG(Engine, Warn, __VA_ARGS__)
+    #define LOG_ERROR(...) CBR_LOG(Engine, Error, __VA_ARGS__)
+    #define LOG_DEBUG(...) CBR_LOG(Engine, Debug, __VA_ARGS__)
+
+    #define LOG_INFO_LIMITED(perSecond, ...)  CBR_LOG_LIMITED(Engine, Info, perSecond, __VA_ARGS__)
+    #define LOG_WARN_LIMITED(perSecond, ...)  CBR_LOG_LIMITED(Engine, Warn, perSecond, __VA_ARGS__)
+    #define LOG_ERROR_LIMITED(perSecond, ...) CBR_LOG_LIMITED(Engine, Error, perSecond, __VA_ARGS__)
+    #define LOG_DEBUG_LIMITED(perSecond, ...) CBR_LOG_LIMITED(Engine, Debug, perSecond, __VA_ARGS__)
+
+    #define LOG_INFO_DEDUP(...)  CBR_LOG_DEDUP(Engine, Info, __VA_ARGS__)
+    #define LOG_WARN_DEDUP(...)  CBR_LOG_DEDUP(Engine, Warn, __VA_ARGS__)
+    #define LOG_ERROR_DEDUP(...) CBR_LOG_DEDUP(Engine, Error, __VA_ARGS__)
+    #define LOG_DEBUG_DEDUP(...) CBR_LOG_DEDUP(Engine, Debug, __VA_ARGS__)
 } //namespace CBR::Engine::Debug
\ No newline at end of file
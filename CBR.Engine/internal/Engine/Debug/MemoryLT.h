@@ -57,11 +57,43 @@ void operator delete[](void* p, const char* file, int line) noexcept;
 
 namespace CBR::Engine::Debug::mlt
 {
+	struct Config
+	{
+		bool heapCorruptionCheck = false;
+		int buffer = 256;
+		bool captureStacks = false;        // ÿηץջ水ջ
+		int stackDepth = 12;               //  16 
+		bool trackPlainNew = false;        // Ҳû __FILE__/__LINE__ ͨ operator new
+		const char* reportPath = nullptr;  // Close ʱѰõܵıдļ
+		int corruptionCheckBudgetUs = 0;   // EndFrame ʱڱʱԤ㣨΢룩0 ʾ
+		bool corruptionCheckThread = false; // ں̨߳ϳ飨ÿҲԤ㣩
+
+		// ҳģʽС [pageGuardMinSize, pageGuardMaxSize] ֮ķһɷʵҳ
+		// ԽдڳָϾͻᴥ쳣ÿռҳֻʺ޶Χʹ
+		std::size_t pageGuardMinSize = 0;
+		std::size_t pageGuardMaxSize = 0;      // 0 ʾʹҳ
+		const char* pageGuardFile = nullptr;   // ֻ __FILE__ ַķ䣬nullptr ʾļ
+
+		// ͷŵĿ 0xDD ŽԤʱȽȳͷţͬʱڼûбд0 ʾر
+		std::size_t quarantineBytes = 0;
+
+		// ¼ּķƬǼǣȡ 2 ݣ 161 ǷƬ֮ǰ̹߳һֻԱ
+		unsigned int registryShards = 16;
+	};
+
 	/** Initialize the MemoryLeakTracker*/
 	void Init(bool heapCorruptionCheck = false, int buffer = 256);
+	void Init(const Config& config);
 	void Close();
 	void CheckHeapCorruption();
 
+	/** Checks guard bands starting where the previous call stopped, until the budget runs out or every block was visited once.
+	*   Returns the number of blocks checked. Each corrupted block is reported only once. */
+	std::size_t CheckHeapCorruptionIncremental(std::chrono::microseconds budget);
+
+	/** Writes live/peak/total statistics grouped by allocation site (and call stack) to a file. */
+	bool WriteAllocationReport(const char* path);
+
 	class BaseLeakTracker
 	{
 	public:
@@ -84,9 +116,29 @@ namespace CBR::Engine::Debug::mlt
 #else //!_DEBUG
 namespace CBR::Engine::Debug::mlt
 {
-	void Init(bool heapCorruptionCheck = false, int buffer = 256){}
-	void Close() {}
-	void CheckHeapCorruption() {}
+	struct Config
+	{
+		bool heapCorruptionCheck = false;
+		int buffer = 256;
+		bool captureStacks = false;
+		int stackDepth = 12;
+		bool trackPlainNew = false;
+		const char* reportPath = nullptr;
+		int corruptionCheckBudgetUs = 0;
+		bool corruptionCheckThread = false;
+		std::size_t pageGuardMinSize = 0;
+		std::size_t pageGuardMaxSize = 0;
+		const char* pageGuardFile = nullptr;
+		std::size_t quarantineBytes = 0;
+		unsigned int registryShards = 16;
+	};
+
+	inline void Init(bool = false, int = 256) {}
+	inline void Init(const Config&) {}
+	inline void Close() {}
+	inline void CheckHeapCorruption() {}
+	inline std::size_t CheckHeapCorruptionIncremental(std::chrono::microseconds) { return 0; }
+	inline bool WriteAllocationReport(const char*) { return false; }
 
     class BaseLeakTracker
     {
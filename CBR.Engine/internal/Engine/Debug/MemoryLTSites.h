@@ -0,0 +1,41 @@
+#pragma once
+
+#if defined(_DEBUG) || defined(DEBUG)
+
+#include "Engine/Debug/StackTrace.h"
+
+namespace CBR::Engine::Debug::mlt
+{
+    /// <summary>
+    ///  õ㣨__FILE__/__LINE__ ϿѡĵջһγʱǼǽȫֱ֮󲻻ƶͷţ
+    ///  ¼ֱӱָ롣ͳȫ relaxed ԭʱӰڷ߳
+    /// </summary>
+    struct AllocationSite
+    {
+        std::atomic<uint64_t> key{ 0 };     // 0 ʾղ
+        std::atomic<bool> ready{ false };   // ֶдΪ true
+        const char* file = nullptr;         // "" ʾͨ operator newûļ
+        unsigned int line = 0;
+        uint16_t depth = 0;
+        void* frames[kMaxStackDepth] = {};
+
+        std::atomic<uint64_t> liveCount{ 0 };
+        std::atomic<uint64_t> liveBytes{ 0 };
+        std::atomic<uint64_t> peakBytes{ 0 };
+        std::atomic<uint64_t> totalCount{ 0 };
+        std::atomic<uint64_t> totalBytes{ 0 };
+    };
+
+    // վ Init ʱһΣcallocվ㶼һվ
+    void InitAllocationSites();
+
+    AllocationSite* InternAllocationSite(const char* file, unsigned int line, void* const* frames, uint16_t depth) noexcept;
+
+    void OnSiteAlloc(AllocationSite* site, std::size_t size) noexcept;
+    void OnSiteFree(AllocationSite* site, std::size_t size) noexcept;
+
+    // ѾǼǵվ㣨ûдģ
+    void ForEachAllocationSite(const std::function<void(const AllocationSite&)>& callback);
+} // namespace CBR::Engine::Debug::mlt
+
+#endif //_DEBUG
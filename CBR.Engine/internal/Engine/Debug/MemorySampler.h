@@ -0,0 +1,50 @@
+#pragma once
+
+namespace CBR::Engine::Debug::mlt
+{
+    struct SamplerConfig
+    {
+        std::size_t sampleIntervalBytes = 512 * 1024; // ƽÿôֽڼ¼һ
+        int stackDepth = 16;                          //  kMaxStackDepth 
+    };
+
+    /// <summary>
+    ///  Debug  Release ¶áȫ operator new ÿһȣƽ sampleIntervalBytes
+    ///  ֲָֽھͼ¼һεǰķ͵ջdelete ʱȥκʱܰջĶѡ
+    ///  ûбķֻһֲ߳̾ļ
+    /// </summary>
+    void StartSampling(const SamplerConfig& config = {});
+    // ֹͣ¼µĲѾ¼Ĳͷ
+    void StopSampling();
+    bool IsSampling() noexcept;
+
+    // ѵǰĲջдļʱԵ
+    bool WriteSampledProfile(const char* path);
+
+    namespace sampler
+    {
+        extern std::atomic<bool> g_enabled;
+        extern std::atomic<uint32_t> g_liveSamples;
+        extern thread_local int64_t t_bytesUntilSample;
+
+        void RecordSample(void* address, std::size_t size) noexcept;
+        void ReleaseSample(void* address) noexcept;
+    }
+
+    // ȫ operator new / delete 
+    inline void OnAllocation(void* address, std::size_t size) noexcept
+    {
+        if (!sampler::g_enabled.load(std::memory_order_relaxed))
+            return;
+        if ((sampler::t_bytesUntilSample -= static_cast<int64_t>(size)) > 0)
+            return;
+        sampler::RecordSample(address, size);
+    }
+
+    inline void OnDeallocation(void* address) noexcept
+    {
+        // ûдĲʱûҪ
+        if (sampler::g_liveSamples.load(std::memory_order_relaxed) != 0)
+            sampler::ReleaseSample(address);
+    }
+} // namespace CBR::Engine::Debug::mlt
@@ -0,0 +1,106 @@
+#pragma once
+
+namespace CBR::Engine::Debug::mlt
+{
+    // Сּ<=16, <=32, ... <=256KBһǸķ
+    constexpr std::size_t kSizeClassCount = 16;
+
+    constexpr std::size_t SizeClassOf(std::size_t size) noexcept
+    {
+        const std::size_t bits = static_cast<std::size_t>(std::bit_width(size > 0 ? size - 1 : 0));
+        return bits <= 4 ? 0 : std::min<std::size_t>(bits - 4, kSizeClassCount - 1);
+    }
+
+    // һޣֽڣһ 0 ʾû
+    constexpr std::size_t SizeClassUpperBound(std::size_t sizeClass) noexcept
+    {
+        return sizeClass + 1 < kSizeClassCount ? (std::size_t{ 16 } << sizeClass) : 0;
+    }
+
+    struct FrameAllocationStats
+    {
+        uint64_t frame = 0;
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t bytesAllocated = 0;
+    };
+
+    struct HeapStats
+    {
+        uint64_t currentBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t currentBlocks = 0;
+        uint64_t totalAllocations = 0;
+        uint64_t totalFrees = 0;
+        FrameAllocationStats lastFrame;                  // һ֡EndFrame ֮䣩ķ
+        uint64_t liveBlocksBySizeClass[kSizeClassCount] = {};
+        uint64_t allocationsBySizeClass[kSizeClassCount] = {};
+    };
+
+    struct SiteStats
+    {
+        const void* id = nullptr;   // վΨһʶ֮Ӧͬһվ
+        const char* file = nullptr; // "" ʾͨ operator new
+        unsigned int line = 0;
+        uint16_t stackDepth = 0;
+        uint64_t liveCount = 0;
+        uint64_t liveBytes = 0;
+        uint64_t peakBytes = 0;
+        uint64_t totalCount = 0;
+        uint64_t totalBytes = 0;
+    };
+
+    enum class SiteSortKey
+    {
+        LiveBytes,
+        PeakBytes,
+        TotalBytes,
+        TotalCount,
+    };
+
+    struct Snapshot
+    {
+        std::chrono::steady_clock::time_point time{};
+        HeapStats heap;
+        std::vector<SiteStats> sites; // еǼǹվ㣬 id 
+    };
+
+    struct SiteDelta
+    {
+        SiteStats site;           // һֵ
+        int64_t liveBytes = 0;    // ֽڵı仯
+        int64_t liveCount = 0;
+        uint64_t allocations = 0; // ο֮ķ
+    };
+
+    struct SnapshotDiff
+    {
+        std::chrono::steady_clock::duration elapsed{};
+        int64_t currentBytes = 0;
+        int64_t currentBlocks = 0;
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        std::vector<SiteDelta> sites; // б仯վ㣬ֽǰ
+    };
+
+    /// ͳֻ relaxed ԭӷ·ϵ߳ͬʱʱ֮΢СĲһ
+#if defined(_DEBUG) || defined(DEBUG)
+    HeapStats GetHeapStats();
+    std::vector<SiteStats> GetTopSites(std::size_t count, SiteSortKey sortKey = SiteSortKey::LiveBytes);
+
+    // ÿ֡ʱһΣGameEngine::Iterationͳһ֡ķ
+    void EndFrame();
+
+    Snapshot TakeSnapshot();
+    SnapshotDiff DiffSnapshots(const Snapshot& before, const Snapshot& after);
+    // ѲժҪ topN վ־Memory ࣩ
+    void LogSnapshotDiff(const SnapshotDiff& diff, std::size_t topN = 10);
+#else
+    inline HeapStats GetHeapStats() { return {}; }
+    inline std::vector<SiteStats> GetTopSites(std::size_t, SiteSortKey = SiteSortKey::LiveBytes) { return {}; }
+    inline void EndFrame() {}
+    inline Snapshot TakeSnapshot() { return {}; }
+    inline SnapshotDiff DiffSnapshots(const Snapshot&, const Snapshot&) { return {}; }
+    inline void LogSnapshotDiff(const SnapshotDiff&, std::size_t = 10) {}
+#endif //_DEBUG
+} // namespace CBR::Engine::Debug::mlt
@@ -0,0 +1,93 @@
+#pragma once
+#include "Engine/Configuration.h"
+
+namespace CBR::Engine::Debug
+{
+    // һ zone һ֡ڼƽÿ֡ĺʱò㼶˳
+    struct ProfileNodeSummary
+    {
+        const char* name = nullptr;
+        uint32_t depth = 0;             // 0 
+        double milliseconds = 0.0;      //  zone
+        double calls = 0.0;
+    };
+
+    /// <summary>
+    ///  ׮ʽ CPU ܷCBR_PROFILE_SCOPE ʱ (name, ʼ, ) д̵߳Ļλ
+    ///  ڴ棨̵߳һμ¼ʱһλͬʱò㼶ۼƺʱ
+    ///   EndFrame ̣̣߳߳Եõÿ֡Ĳ㼶ܡ
+    ///  WriteChromeTrace  Chrome Trace / Perfetto ܴ򿪵 JSONchrome://tracingui.perfetto.dev
+    ///  û Start ʱÿ zone ֻһԭӶ
+    /// </summary>
+    class Profiler
+    {
+    public:
+        static constexpr std::size_t kEventsPerThread = 1 << 16;    // ÿ̱߳ô zone
+        static constexpr std::size_t kMaxNodes = 1024;              // ÿ̲߳ͬ·
+        static constexpr std::size_t kMaxDepth = 64;
+        static constexpr std::size_t kMaxFrames = 4096;             // ô֡֡
+
+        //  Start ʼ¼֮ǰ¼ᵼ
+        static void Start();
+        static void Stop();
+        static bool IsEnabled() noexcept { return s_enabled.load(std::memory_order_relaxed); }
+
+        // ֡ǣ GameEngine::Iteration ֡ͷͽβ
+        static void BeginFrame(uint64_t frameIndex) noexcept;
+        static void EndFrame() noexcept;
+
+        static std::vector<ProfileNodeSummary> GetLastFrameSummary();
+        static std::vector<ProfileNodeSummary> GetAverageFrameSummary();
+
+        static bool WriteChromeTrace(const char* path);
+
+    private:
+        friend class ProfileScope;
+        struct ThreadProfile;
+
+        static ThreadProfile* AcquireThreadProfile() noexcept;
+        static std::vector<ProfileNodeSummary> BuildSummary(const uint64_t* ticks, const uint64_t* calls, double frames);
+
+        static inline std::atomic<bool> s_enabled{ false };
+        static inline std::atomic<ThreadProfile*> s_profiles{ nullptr };     // ֻ̽ǰͷ
+        static inline std::atomic<ThreadProfile*> s_mainThread{ nullptr };   //  EndFrame ߳
+        static inline thread_local ThreadProfile* t_profile = nullptr;
+    };
+
+    class ProfileScope
+    {
+    public:
+        // name ָ̬洢ַ
+        explicit ProfileScope(const char* name) noexcept
+        {
+            if (Profiler::IsEnabled())
+                Begin(name);
+        }
+
+        ~ProfileScope()
+        {
+            if (profile_)
+                End();
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator= (const ProfileScope&) = delete;
+
+    private:
+        void Begin(const char* name) noexcept;
+        void End() noexcept;
+
+        Profiler::ThreadProfile* profile_ = nullptr;
+        const char* name_ = nullptr;
+        uint64_t begin_ = 0;
+    };
+}
+
+#if CBR_ENABLE_PROFILER
+#define CBR_PROFILE_CONCAT_INNER(a, b) a##b
+#define CBR_PROFILE_CONCAT(a, b) CBR_PROFILE_CONCAT_INNER(a, b)
+// CBR_PROFILE_SCOPE("Renderer::Render");
+#define CBR_PROFILE_SCOPE(name) ::CBR::Engine::Debug::ProfileScope CBR_PROFILE_CONCAT(cbrProfileScope_, __LINE__)(name)
+#else
+#define CBR_PROFILE_SCOPE(name) ((void)0)
+#endif
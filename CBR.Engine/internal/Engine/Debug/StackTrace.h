@@ -0,0 +1,12 @@
+#pragma once
+
+namespace CBR::Engine::Debug
+{
+    constexpr std::size_t kMaxStackDepth = 16;
+
+    // ץǰ̵߳ĵջ skip 㣨Լڴ棬 operator new 
+    uint16_t CaptureStack(void** frames, uint16_t maxDepth, uint32_t skip) noexcept;
+
+    // һصַתɲԵַı+ƫ / ģ+ƫƣֱ֮ͬ diff
+    std::string DescribeFrame(void* frame);
+} // namespace CBR::Engine::Debug
@@ -13,7 +13,7 @@ namespace CBR::Engine::Graphics
 		void Shutdown() override;
 		void BeginFrame() override;
 		void EndFrame() override;
-		void Render() override;
+		void Render(float alpha) override;
 
 	private:
 		HRESULT InitDevice();
@@ -13,7 +13,7 @@ namespace CBR::Engine::Graphics
 		static void Shutdown();
 		static void BeginFrame();
 		static void EndFrame();
-		static void Render();
+		static void Render(float alpha);
 
 	private:
 		static inline std::unique_ptr<IRenderer> instance_;
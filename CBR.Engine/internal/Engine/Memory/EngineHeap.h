@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Engine/Configuration.h"
+#include "Engine/Memory/PoolAllocator.h"
+#include "Engine/Memory/MemoryTagTracking.h"
+
+namespace CBR::Engine::Memory
+{
+    // ȫ operator new / deleteй© FrameArena ĵײ䡣
+    // CBR_USE_POOL_ALLOCATOR óػ mallocCBR_ENABLE_MEMORY_TAGS ʱÿǰ 16 ֽڼ¼Сͱǩ
+    namespace heap
+    {
+        inline void* AllocateRaw(std::size_t size) noexcept
+        {
+#if CBR_USE_POOL_ALLOCATOR
+            return PoolAllocate(size);
+#else
+            return std::malloc(size ? size : 1);
+#endif
+        }
+
+        inline void FreeRaw(void* p) noexcept
+        {
+#if CBR_USE_POOL_ALLOCATOR
+            PoolFree(p);
+#else
+            std::free(p);
+#endif
+        }
+    }
+
+    inline void* EngineAlloc(std::size_t size) noexcept
+    {
+#if CBR_ENABLE_MEMORY_TAGS
+        if (size > std::numeric_limits<std::size_t>::max() - sizeof(tagging::BlockHeader))
+            return nullptr;
+        return tagging::Attach(heap::AllocateRaw(size + sizeof(tagging::BlockHeader)), size);
+#else
+        return heap::AllocateRaw(size);
+#endif
+    }
+
+    inline void* EngineAllocZeroed(std::size_t size) noexcept
+    {
+        void* p = EngineAlloc(size);
+        if (p)
+            std::memset(p, 0, size);
+        return p;
+    }
+
+    inline void EngineFree(void* p) noexcept
+    {
+        if (!p)
+            return;
+#if CBR_ENABLE_MEMORY_TAGS
+        heap::FreeRaw(tagging::Detach(p));
+#else
+        heap::FreeRaw(p);
+#endif
+    }
+} // namespace CBR::Engine::Memory
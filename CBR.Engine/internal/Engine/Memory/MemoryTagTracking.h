@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Engine/Configuration.h"
+#include "Engine/Memory/MemoryTag.h"
+
+namespace CBR::Engine::Memory
+{
+    // ÿ֡ʱãGameEngine::IterationԤıǩ
+    void CheckMemoryBudgets();
+
+    // ʽ CBR_LOG_LEVELS һ"Renderer=64M, Game=512M!"׺ K/M/Gβ ! ʾʱԡ޷Ŀ
+    int ConfigureMemoryBudgets(std::string_view spec);
+    // ȡ CBR_MEMORY_BUDGETS
+    void LoadMemoryBudgets();
+
+    namespace tagging
+    {
+        // ÿ߳һֻԼдҪԭӵĶ--дȡһ
+        struct alignas(64) ThreadCounters
+        {
+            std::atomic<int64_t> liveBytes[kMemoryTagCount];
+        };
+
+        extern constinit thread_local MemoryTag t_currentTag;
+        extern constinit thread_local ThreadCounters* t_counters;
+
+        // һηʱ̷߳һֲ̫߳߳˳ʱֱӼӵȫּ
+        void AddSlow(MemoryTag tag, int64_t bytes) noexcept;
+
+        inline void Add(MemoryTag tag, int64_t bytes) noexcept
+        {
+            if (ThreadCounters* counters = t_counters)
+            {
+                std::atomic<int64_t>& counter = counters->liveBytes[static_cast<std::size_t>(tag)];
+                counter.store(counter.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+                return;
+            }
+            AddSlow(tag, bytes);
+        }
+
+        // ÿǰ棬 16 ֽڶ
+        struct alignas(16) BlockHeader
+        {
+            std::size_t size;
+            MemoryTag tag;
+        };
+        static_assert(sizeof(BlockHeader) == 16);
+
+        inline void* Attach(void* raw, std::size_t size) noexcept
+        {
+            if (!raw)
+                return nullptr;
+            BlockHeader* header = static_cast<BlockHeader*>(raw);
+            header->size = size;
+            header->tag = t_currentTag;
+            Add(header->tag, static_cast<int64_t>(size));
+            return header + 1;
+        }
+
+        inline void* Detach(void* p) noexcept
+        {
+            BlockHeader* header = static_cast<BlockHeader*>(p) - 1;
+            Add(header->tag, -static_cast<int64_t>(header->size));
+            return header;
+        }
+    }
+} // namespace CBR::Engine::Memory
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Engine/Memory/NoAllocScope.h"
+
+namespace CBR::Engine::Memory
+{
+    // ȡ CBR_NOALLOC0/1/2
+    void LoadNoAllocMode();
+
+    // ֡ĩãGameEngine::Iterationͳһ֡ķ䣬Υʱһл
+    void EndNoAllocFrame();
+
+    // λдΥ棨ֽڡջûΥʱҲдļͷ
+    bool WriteNoAllocReport(const char* path);
+
+    namespace noalloc
+    {
+        struct ThreadState
+        {
+            int depth;              // Ƕ׵ NoAllocScope AllowAllocScope ʱ
+            const char* region;     // ڲ NoAllocScope 
+            uint64_t allocations;   // ߳̾ operator new ķ
+            uint64_t bytes;
+        };
+
+        extern constinit thread_local ThreadState t_state;
+
+        void ReportViolation(std::size_t size, const char* file, unsigned int line) noexcept;
+    }
+
+    // ȫ operator new áfile Ϊ nullptr ʾͨ new
+    inline void OnOperatorNew(std::size_t size, const char* file, unsigned int line) noexcept
+    {
+        noalloc::ThreadState& state = noalloc::t_state;
+        ++state.allocations;
+        state.bytes += size;
+        if (state.depth != 0)
+            noalloc::ReportViolation(size, file, line);
+    }
+} // namespace CBR::Engine::Memory
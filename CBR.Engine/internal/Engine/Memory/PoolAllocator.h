@@ -0,0 +1,32 @@
+#pragma once
+
+namespace CBR::Engine::Memory
+{
+    constexpr std::size_t kPoolChunkSize = 64 * 1024;   // Сô chunk г
+    constexpr std::size_t kPoolMaxSmallSize = 8 * 1024; // ķֱϵͳҪ
+    constexpr std::size_t kPoolSizeClassCount = 32;     // 16..128 ÿ 16 ֽһ֮ÿһ 4 
+
+    /// <summary>
+    ///  ͨöѡС鰴Сּÿ̻߳һֿп飬ͷͨ
+    ///  ̻߳泬ʱĲֿ⣬̴߳ȡڱ߳ͷŵĿͷ߳ԼĻ棬
+    ///  Ҫ泬޻߳˳ŻصĲֿ⣬ֱ̲߳û
+    ///  chunk ʱһַռͷʱַΧСֱϵͳҪĴ顣
+    ///  صڴ水 16 ֽڶ롣chunk ϵͳ
+    /// </summary>
+    void* PoolAllocate(std::size_t size) noexcept; // ʧܷ nullptr
+    void PoolFree(void* p) noexcept;
+    // ʵʿõֽСּȡ
+    std::size_t PoolUsableSize(const void* p) noexcept;
+    // ѵǰ̻߳Ŀп黹Ĳֿ⣻߳˳ʱԶ
+    void PoolFlushThreadCache() noexcept;
+
+    struct PoolStats
+    {
+        uint64_t reservedBytes = 0;  // ĵַռ
+        uint64_t chunkBytes = 0;     // Ѿύ chunk
+        uint64_t largeBlocks = 0;    // ֱϵͳҪĿ
+        uint64_t largeBytes = 0;
+        uint64_t centralBlocks = 0;  // ĲֿĿС
+    };
+    PoolStats GetPoolStats() noexcept;
+} // namespace CBR::Engine::Memory
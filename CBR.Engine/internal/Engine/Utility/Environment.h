@@ -0,0 +1,59 @@
+#pragma once
+
+namespace CBR::Engine::Utility
+{
+    // ȡʱؿַgetenv  /sdl ǴC4996Windows ϸ _dupenv_s
+    inline std::string ReadEnvironmentVariable(const char* name)
+    {
+#ifdef _WIN32
+        char* buffer = nullptr;
+        std::size_t length = 0;
+        if (_dupenv_s(&buffer, &length, name) != 0 || buffer == nullptr)
+            return {};
+        std::string value(buffer);
+        free(buffer);
+        return value;
+#else
+        const char* value = std::getenv(name);
+        return value ? std::string(value) : std::string();
+#endif
+    }
+
+    inline std::string_view Trim(std::string_view s) noexcept
+    {
+        while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) s.remove_prefix(1);
+        while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) s.remove_suffix(1);
+        return s;
+    }
+
+    inline bool EqualsIgnoreCase(std::string_view a, std::string_view b) noexcept
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+            [](char x, char y) { return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y)); });
+    }
+
+    //  "name=value,name=value" ʽãCBR_LOG_LEVELSCBR_MEMORY_BUDGETS ͶӦļ
+    // Ŀ , ; зָĿ # ͷĿname  value Ѿȥβհס
+    // ÿĿ entry(name, value) false ʾ޷ʶ𡣷û = ޷ʶĿ
+    template<typename Callback>
+    int ForEachSpecEntry(std::string_view spec, Callback&& entry)
+    {
+        int errors = 0;
+
+        while (!spec.empty())
+        {
+            const std::size_t end = spec.find_first_of(",;\n");
+            const std::string_view item = Trim(spec.substr(0, end));
+            spec = (end == std::string_view::npos) ? std::string_view() : spec.substr(end + 1);
+
+            if (item.empty() || item.front() == '#')
+                continue;
+
+            const std::size_t eq = item.find('=');
+            if (eq == std::string_view::npos || !entry(Trim(item.substr(0, eq)), Trim(item.substr(eq + 1))))
+                ++errors;
+        }
+
+        return errors;
+    }
+} // namespace CBR::Engine::Utility
@@ -1,24 +1,49 @@
 /// Engine.pch ///
 #pragma once
 
+#ifdef _WIN32
 #include <Windows.h>
-#include <cstdio>
 #include <io.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <cstdio>
+#include <cerrno>
+#include <csignal>
 #include <fcntl.h>
 #include <iostream>
 #include <unordered_set>
 #include <memory>
+#include <memory_resource>
+#include <vector>
+#include <functional>
 #include <cassert>
+#include <cctype>
+#include <optional>
+#include <cstring>
+#include <cmath>
+#include <charconv>
+#include <limits>
+#include <algorithm>
 
 #include <string_view>
 #include <sstream>
+#include <format>
 #include <chrono>
 #include <iomanip>
 #include <source_location>
 #include <mutex>
+#include <condition_variable>
 #include <ranges>
+#include <atomic>
+#include <thread>
+#include <bit>
+#include <fstream>
+#include <filesystem>
 
 // Renderer
+#ifdef _WIN32
 #include <wrl/client.h> // Microsoft::WRL::ComPtr
 #include <wrl.h>
 #include <d3d11.h>
@@ -26,4 +51,5 @@
 // #pragma comment(lib, "d3d11.lib")
 // #pragma comment(lib, "dxgi.lib")
 // #pragma comment(lib, "d3dcompiler.lib")
-#include <d3d11_1.h>
\ No newline at end of file
+#include <d3d11_1.h>
+#endif // _WIN32
\ No newline at end of file
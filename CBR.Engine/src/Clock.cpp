@@ -0,0 +1,248 @@
+#include "pch.h"
+#include "Engine/Utility/Clock.h"
+#include "Engine/Utility/Environment.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CBR_CLOCK_HAS_TSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#else
+#define CBR_CLOCK_HAS_TSC 0
+#if defined(_MSC_VER) && defined(_M_ARM64)
+#include <intrin.h> // __umulh
+#endif
+#endif
+
+namespace CBR::Engine::Utility
+{
+    namespace
+    {
+        // tick -> ns: (ticks * mult) >> kShift˷ 128 λֵҲ
+        constexpr uint32_t kShift = 32;
+        static_assert(kShift > 0 && kShift < 64);
+
+        struct ClockState
+        {
+            ClockSource source = ClockSource::Platform;
+            uint64_t frequency = 0;
+            uint64_t toNanosecondsMult = 0;
+            uint64_t fromNanosecondsMult = 0;
+            uint64_t baseTicks = 0;
+            std::chrono::system_clock::time_point baseSystemTime{};
+        };
+
+        // ʼ̬ʼ֮ǰ Now() Ҳܶƽ̨ʱӣֻתΪ 0
+        constinit ClockState State_{};
+
+        uint64_t MulShift(uint64_t value, uint64_t mult) noexcept
+        {
+#if defined(__SIZEOF_INT128__)
+            return static_cast<uint64_t>((static_cast<unsigned __int128>(value) * mult) >> kShift);
+#elif defined(_M_X64)
+            uint64_t high = 0;
+            const uint64_t low = _umul128(value, mult, &high);
+            return __shiftright128(low, high, kShift);
+#else
+            uint64_t low = 0;
+            uint64_t high = 0;
+#if defined(_M_ARM64)
+            low = value * mult;
+            high = __umulh(value, mult);
+#else
+            // Win32 û 128 λ˷ 4  32x32 Ĳֻƴ 128 λ
+            // mult Գ 2^3210 MHz QPC  tick -> ns  100 * 2^32ֻ value 
+            const uint64_t valueLow = value & 0xFFFFFFFFull;
+            const uint64_t valueHigh = value >> 32;
+            const uint64_t multLow = mult & 0xFFFFFFFFull;
+            const uint64_t multHigh = mult >> 32;
+
+            const uint64_t lowLow = valueLow * multLow;
+            const uint64_t lowHigh = valueLow * multHigh;
+            const uint64_t highLow = valueHigh * multLow;
+            const uint64_t highHigh = valueHigh * multHigh;
+
+            // м 32 λ 3 * (2^32 - 1) 64 λ
+            const uint64_t middle = (lowLow >> 32) + (lowHigh & 0xFFFFFFFFull) + (highLow & 0xFFFFFFFFull);
+            low = (middle << 32) | (lowLow & 0xFFFFFFFFull);
+            high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+#endif
+            return (high << (64 - kShift)) | (low >> kShift);
+#endif
+        }
+
+        uint64_t ComputeMult(uint64_t from, uint64_t to) noexcept
+        {
+            return static_cast<uint64_t>(std::ldexp(static_cast<double>(to) / static_cast<double>(from), kShift) + 0.5);
+        }
+
+        uint64_t ReadPlatformTicks() noexcept
+        {
+#ifdef _WIN32
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+            return static_cast<uint64_t>(now.QuadPart);
+#else
+            timespec ts;
+            clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+        }
+
+        uint64_t PlatformFrequency() noexcept
+        {
+#ifdef _WIN32
+            LARGE_INTEGER freq;
+            QueryPerformanceFrequency(&freq);
+            return static_cast<uint64_t>(freq.QuadPart);
+#else
+            return 1000000000ull;
+#endif
+        }
+
+#if CBR_CLOCK_HAS_TSC
+        uint64_t ReadTsc() noexcept
+        {
+            return __rdtsc();
+        }
+
+        // CPUID 0x80000007 EDX bit 8TSC Ƶʺ㶨潵Ƶ߱仯
+        bool HasInvariantTsc() noexcept
+        {
+#ifdef _MSC_VER
+            int regs[4] = {};
+            __cpuid(regs, 0x80000000);
+            if (static_cast<uint32_t>(regs[0]) < 0x80000007u)
+                return false;
+            __cpuid(regs, 0x80000007);
+            return (regs[3] & (1 << 8)) != 0;
+#else
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u)
+                return false;
+            __get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx);
+            return (edx & (1u << 8)) != 0;
+#endif
+        }
+
+        // ƽ̨ʱӲ TSC Ƶʡȡ̵ˣٱռӰ
+        uint64_t CalibrateTsc() noexcept
+        {
+            constexpr auto kCalibrationTime = std::chrono::milliseconds(20);
+            const uint64_t platformFrequency = PlatformFrequency();
+
+            auto sample = [](uint64_t& platform, uint64_t& tsc)
+            {
+                uint64_t best = UINT64_MAX;
+                for (int i = 0; i < 5; ++i)
+                {
+                    const uint64_t before = ReadTsc();
+                    const uint64_t ticks = ReadPlatformTicks();
+                    const uint64_t after = ReadTsc();
+                    if (after - before < best)
+                    {
+                        best = after - before;
+                        platform = ticks;
+                        tsc = before + (after - before) / 2;
+                    }
+                }
+            };
+
+            uint64_t platformStart = 0, tscStart = 0, platformEnd = 0, tscEnd = 0;
+            sample(platformStart, tscStart);
+            std::this_thread::sleep_for(kCalibrationTime);
+            sample(platformEnd, tscEnd);
+
+            const uint64_t platformElapsed = platformEnd - platformStart;
+            if (platformElapsed == 0)
+                return 0;
+            return static_cast<uint64_t>(static_cast<double>(tscEnd - tscStart) * static_cast<double>(platformFrequency) / static_cast<double>(platformElapsed) + 0.5);
+        }
+#endif
+
+        void InitializeClock()
+        {
+            ClockState state;
+            state.source = ClockSource::Platform;
+            state.frequency = PlatformFrequency();
+
+            const std::string requested = ReadEnvironmentVariable("CBR_CLOCK");
+#if CBR_CLOCK_HAS_TSC
+            if (requested == "tsc" && HasInvariantTsc())
+            {
+                if (const uint64_t tscFrequency = CalibrateTsc(); tscFrequency != 0)
+                {
+                    state.source = ClockSource::Tsc;
+                    state.frequency = tscFrequency;
+                }
+            }
+#endif
+            state.toNanosecondsMult = ComputeMult(state.frequency, 1000000000ull);
+            state.fromNanosecondsMult = ComputeMult(1000000000ull, state.frequency);
+            State_ = state;
+
+            // ׼лʱԴ֮ȡ
+            State_.baseTicks = Clock::Now();
+            State_.baseSystemTime = std::chrono::system_clock::now();
+        }
+
+        // LoggerTimer  main ֮Ŵ̬ʼ׶ѡʱԴ
+        [[maybe_unused]] const bool ClockInitialized_ = (InitializeClock(), true);
+    }
+
+    uint64_t Clock::Now() noexcept
+    {
+#if CBR_CLOCK_HAS_TSC
+        if (State_.source == ClockSource::Tsc)
+            return ReadTsc();
+#endif
+        return ReadPlatformTicks();
+    }
+
+    uint64_t Clock::ToNanoseconds(uint64_t ticks) noexcept
+    {
+        return MulShift(ticks, State_.toNanosecondsMult);
+    }
+
+    uint64_t Clock::FromNanoseconds(uint64_t nanoseconds) noexcept
+    {
+        return MulShift(nanoseconds, State_.fromNanosecondsMult);
+    }
+
+    uint64_t Clock::Frequency() noexcept
+    {
+        return State_.frequency;
+    }
+
+    ClockSource Clock::Source() noexcept
+    {
+        return State_.source;
+    }
+
+    const char* Clock::SourceName() noexcept
+    {
+        switch (State_.source)
+        {
+        case ClockSource::Tsc:
+            return "tsc";
+        case ClockSource::Platform:
+            break;
+        }
+#ifdef _WIN32
+        return "qpc";
+#else
+        return "monotonic_raw";
+#endif
+    }
+
+    std::chrono::system_clock::time_point Clock::ToSystemTime(uint64_t ticks) noexcept
+    {
+        const int64_t elapsed = ticks >= State_.baseTicks
+            ? static_cast<int64_t>(ToNanoseconds(ticks - State_.baseTicks))
+            : -static_cast<int64_t>(ToNanoseconds(State_.baseTicks - ticks));
+        return State_.baseSystemTime + std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(elapsed));
+    }
+}
@@ -12,14 +12,14 @@ namespace CBR::Engine::Graphics
 		HRESULT hr = InitDevice();
 		if (FAILED(hr))
 		{
-			LOG_ERROR("DX11 device failed initialization! [HRESULT = 0x" + std::to_string(hr) + "]");
+			CBR_LOG(Renderer, Error, "DX11 device failed initialization! [HRESULT = 0x{:08X}]", static_cast<uint32_t>(hr));
 			return false;
 		}
 
 		hr = InitSwapchain();
 		if (FAILED(hr))
 		{
-			LOG_ERROR("DX11 swapchain failed initialization! [HRESULT = 0x" + std::to_string(hr) + "]");
+			CBR_LOG(Renderer, Error, "DX11 swapchain failed initialization! [HRESULT = 0x{:08X}]", static_cast<uint32_t>(hr));
 			return false;
 		}
 
@@ -27,7 +27,7 @@ namespace CBR::Engine::Graphics
 		hr = CreateRenderTargetView();
 		if (FAILED(hr))
 		{
-			LOG_ERROR("DX11 failed to create RTV! [HRESULT = 0x" + std::to_string(hr) + "]");
+			CBR_LOG(Renderer, Error, "DX11 failed to create RTV! [HRESULT = 0x{:08X}]", static_cast<uint32_t>(hr));
 			return false;
 		}
 
@@ -35,7 +35,7 @@ namespace CBR::Engine::Graphics
 		hr = CreateDepthStencilView();
 		if (FAILED(hr))
 		{
-			LOG_ERROR("DX11 failed to create DepthStencilView! [HRESULT = 0x" + std::to_string(hr) + "]");
+			CBR_LOG(Renderer, Error, "DX11 failed to create DepthStencilView! [HRESULT = 0x{:08X}]", static_cast<uint32_t>(hr));
 			return false;
 		}
 
@@ -69,8 +69,9 @@ namespace CBR::Engine::Graphics
 
 	}
 
-	void D3D11Renderer::Render()
+	void D3D11Renderer::Render(float alpha)
 	{
+		UNREFERENCED_PARAMETER(alpha); // ûҪֵ
 		const float clearColor[4] = { 0.2f, 0.3f, 0.4f, 1.0f };
 		context_->ClearRenderTargetView(renderTargetView_.Get(), clearColor);
 	}
@@ -168,17 +169,17 @@ namespace CBR::Engine::Graphics
 					//hr = adapter->GetParent(__uuidof(IDXGIFactory1), reinterpret_cast<void**>(dxgiFactory1.GetAddressOf()));
 					hr = adapter->GetParent(IID_PPV_ARGS(&dxgiFactory1));
 					adapter.Reset();
-					if (FAILED(hr)) LOG_ERROR("DX11 failed to accquire IDXGIFactory1 interface! [HRESULT = 0x" + std::to_string(hr) + "]");
+					if (FAILED(hr)) CBR_LOG(Renderer, Error, "DX11 failed to accquire IDXGIFactory1 interface! [HRESULT = 0x{:08X}]", static_cast<uint32_t>(hr));
 				}
 				else 
 				{
-					LOG_ERROR("DX11 failed to get adapter interface! [HRESULT = 0x" + std::to_string(hr) + "]");
+					CBR_LOG(Renderer, Error, "DX11 failed to get adapter interface! [HRESULT = 0x{:08X}]", static_cast<uint32_t>(hr));
 				}
 				dxgiDevice.Reset();
 			}
 			else
 			{
-				LOG_ERROR("DX11 failed to accquire IDXGIDevice interface! [HRESULT = 0x" + std::to_string(hr) + "]");
+				CBR_LOG(Renderer, Error, "DX11 failed to accquire IDXGIDevice interface! [HRESULT = 0x{:08X}]", static_cast<uint32_t>(hr));
 			}
 		}
 		if (FAILED(hr))
@@ -312,7 +313,7 @@ namespace CBR::Engine::Graphics
 			depthStencil_.GetAddressOf());
 		if (FAILED(hr))
 		{
-			LOG_ERROR("DX11 failed to create depthStencil texture2D! [HRESULT = 0x" + std::to_string(hr) + "]");
+			CBR_LOG(Renderer, Error, "DX11 failed to create depthStencil texture2D! [HRESULT = 0x{:08X}]", static_cast<uint32_t>(hr));
 			return hr;
 		}
 
@@ -336,7 +337,7 @@ namespace CBR::Engine::Graphics
 			depthStencilView_.GetAddressOf());
 		if (FAILED(hr))
 		{
-			LOG_ERROR("DX11 failed to create DepthStencilView! [HRESULT = 0x" + std::to_string(hr) + "]");
+			CBR_LOG(Renderer, Error, "DX11 failed to create DepthStencilView! [HRESULT = 0x{:08X}]", static_cast<uint32_t>(hr));
 			return hr;
 		}
 
@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "Engine/Debug/DebugManager.h"
 #include "Engine/Debug/MemoryLT.h"
+#include "Engine/Utility/Environment.h"
 
 namespace CBR::Engine::Debug
 {
@@ -52,8 +53,28 @@ namespace CBR::Engine::Debug
 #if defined(_DEBUG) || defined(DEBUG)
         if (!memoryTrackingEnabled_)
         {
-            // ڴй©
-            mlt::Init(true, 256);
+            // ڴй©⡣CBR_MLT_STACKS=1 ջ飬CBR_MLT_TRACK_ALL=1 ͨ new Ҳ١
+            // ڱÿ֡ CBR_MLT_CHECK_BUDGET_US ΢루Ĭ 200CBR_MLT_CHECK_THREAD=1 Ϊ̨̼߳
+            mlt::Config config;
+            config.heapCorruptionCheck = true;
+            config.buffer = 256;
+            const std::string checkBudget = Utility::ReadEnvironmentVariable("CBR_MLT_CHECK_BUDGET_US");
+            config.corruptionCheckBudgetUs = checkBudget.empty() ? 200 : std::atoi(checkBudget.c_str());
+            config.corruptionCheckThread = Utility::ReadEnvironmentVariable("CBR_MLT_CHECK_THREAD") == "1";
+            // ҳCBR_MLT_PAGE_GUARD=<ֽ>ѡ CBR_MLT_PAGE_GUARD_MIN=<Сֽ>CBR_MLT_PAGE_GUARD_FILE=<ļһ>
+            const std::string pageGuardMax = Utility::ReadEnvironmentVariable("CBR_MLT_PAGE_GUARD");
+            const std::string pageGuardMin = Utility::ReadEnvironmentVariable("CBR_MLT_PAGE_GUARD_MIN");
+            const std::string pageGuardFile = Utility::ReadEnvironmentVariable("CBR_MLT_PAGE_GUARD_FILE");
+            config.pageGuardMaxSize = static_cast<std::size_t>(std::strtoull(pageGuardMax.c_str(), nullptr, 10));
+            config.pageGuardMinSize = static_cast<std::size_t>(std::strtoull(pageGuardMin.c_str(), nullptr, 10));
+            config.pageGuardFile = pageGuardFile.empty() ? nullptr : pageGuardFile.c_str(); // Init Ḵ
+            // ͷź룺CBR_MLT_QUARANTINE_MB=<С>
+            const std::string quarantine = Utility::ReadEnvironmentVariable("CBR_MLT_QUARANTINE_MB");
+            config.quarantineBytes = static_cast<std::size_t>(std::strtoull(quarantine.c_str(), nullptr, 10)) << 20;
+            config.captureStacks = Utility::ReadEnvironmentVariable("CBR_MLT_STACKS") == "1";
+            config.trackPlainNew = Utility::ReadEnvironmentVariable("CBR_MLT_TRACK_ALL") == "1";
+            config.reportPath = "cbr_memory_report.txt";
+            mlt::Init(config);
             memoryTrackingEnabled_ = true;
         }
 #endif
@@ -68,5 +89,8 @@ namespace CBR::Engine::Debug
 
             memoryTrackingEnabled_ = false;
         }
+
+        // й©ҲҪ꣨д߳ GameEngine::Shutdown ֹͣ
+        logger_.Flush();
     }
 }
\ No newline at end of file
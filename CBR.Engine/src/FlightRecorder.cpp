@@ -0,0 +1,405 @@
+#include "pch.h"
+#include "Engine/Debug/FlightRecorder.h"
+#include "Engine/Debug/Logger.h"
+
+namespace CBR::Engine::Debug
+{
+    namespace
+    {
+        constexpr std::size_t kMaxDumpThreads = 64;
+        constexpr std::size_t kMaxDumpSites = 1024;     // 2
+        constexpr std::size_t kDumpBufferSize = 64 * 1024;
+
+        std::atomic<std::size_t> g_ringCapacity{ 0 };
+        std::filesystem::path g_dumpPath;
+        std::atomic<bool> g_dumping{ false };
+
+        // dump ʱõľ̬ﲻڴ
+        char g_dumpBuffer[kDumpBufferSize];
+        const LogSite* g_dumpSites[kMaxDumpSites];
+
+        uint32_t CurrentThreadId() noexcept
+        {
+#ifdef _WIN32
+            return static_cast<uint32_t>(GetCurrentThreadId());
+#else
+            return static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+#endif
+        }
+
+        /// <summary>
+        ///  ֱϵͳдļСд CRT Ͷ
+        /// </summary>
+        class DumpWriter
+        {
+        public:
+            explicit DumpWriter(const std::filesystem::path& path) noexcept
+            {
+#ifdef _WIN32
+                file_ = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+                fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+            }
+
+            ~DumpWriter()
+            {
+                FlushBuffer();
+#ifdef _WIN32
+                if (file_ != INVALID_HANDLE_VALUE)
+                {
+                    FlushFileBuffers(file_);
+                    CloseHandle(file_);
+                }
+#else
+                if (fd_ >= 0)
+                {
+                    ::fsync(fd_);
+                    ::close(fd_);
+                }
+#endif
+            }
+
+            bool IsOpen() const noexcept
+            {
+#ifdef _WIN32
+                return file_ != INVALID_HANDLE_VALUE;
+#else
+                return fd_ >= 0;
+#endif
+            }
+
+            void Write(const void* data, std::size_t size) noexcept
+            {
+                const char* bytes = static_cast<const char*>(data);
+                while (size > 0)
+                {
+                    if (used_ == kDumpBufferSize)
+                        FlushBuffer();
+
+                    const std::size_t chunk = std::min<std::size_t>(size, kDumpBufferSize - used_);
+                    std::memcpy(g_dumpBuffer + used_, bytes, chunk);
+                    used_ += chunk;
+                    bytes += chunk;
+                    size -= chunk;
+                }
+            }
+
+            template<typename T>
+            void Put(const T& value) noexcept { Write(&value, sizeof(value)); }
+
+        private:
+            void FlushBuffer() noexcept
+            {
+                if (used_ == 0 || !IsOpen())
+                    return;
+#ifdef _WIN32
+                DWORD written = 0;
+                WriteFile(file_, g_dumpBuffer, static_cast<DWORD>(used_), &written, nullptr);
+#else
+                std::size_t offset = 0;
+                while (offset < used_)
+                {
+                    const ssize_t n = ::write(fd_, g_dumpBuffer + offset, used_ - offset);
+                    if (n <= 0)
+                        break;
+                    offset += static_cast<std::size_t>(n);
+                }
+#endif
+                used_ = 0;
+            }
+
+#ifdef _WIN32
+            HANDLE file_ = INVALID_HANDLE_VALUE;
+#else
+            int fd_ = -1;
+#endif
+            std::size_t used_ = 0;
+        };
+
+        // صõ dump ļ idһγʱ isNew Ϊ trueԺÿ¼¶壨id ̶Ϊ kMaxDumpSites + 1
+        uint32_t DumpSiteId(const LogSite* site, bool& isNew) noexcept
+        {
+            std::size_t slot = (reinterpret_cast<uintptr_t>(site) >> 4) & (kMaxDumpSites - 1);
+            for (std::size_t probe = 0; probe < kMaxDumpSites; ++probe)
+            {
+                if (g_dumpSites[slot] == site)
+                {
+                    isNew = false;
+                    return static_cast<uint32_t>(slot + 1);
+                }
+                if (g_dumpSites[slot] == nullptr)
+                {
+                    g_dumpSites[slot] = site;
+                    isNew = true;
+                    return static_cast<uint32_t>(slot + 1);
+                }
+                slot = (slot + 1) & (kMaxDumpSites - 1);
+            }
+            isNew = true;
+            return static_cast<uint32_t>(kMaxDumpSites + 1);
+        }
+
+        std::terminate_handler g_previousTerminate = nullptr;
+
+        [[noreturn]] void TerminateHandler()
+        {
+            FlightRecorder::Dump();
+            if (g_previousTerminate)
+                g_previousTerminate();
+            std::abort();
+        }
+
+#ifdef _WIN32
+        LPTOP_LEVEL_EXCEPTION_FILTER g_previousFilter = nullptr;
+
+        LONG WINAPI UnhandledExceptionHandler(EXCEPTION_POINTERS* info)
+        {
+            FlightRecorder::Dump();
+            return g_previousFilter ? g_previousFilter(info) : EXCEPTION_CONTINUE_SEARCH;
+        }
+
+        void AbortSignalHandler(int sig)
+        {
+            FlightRecorder::Dump();
+            std::signal(sig, SIG_DFL);
+            std::raise(sig);
+        }
+#else
+        constexpr int kFatalSignals[] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT };
+        char g_signalStack[64 * 1024]; // ջʱźŴҪջ
+
+        void FatalSignalHandler(int sig)
+        {
+            FlightRecorder::Dump();
+            // SA_RESETHAND ѾָĬϴ´ý̰ԭķʽcore dump ȣ
+            ::raise(sig);
+        }
+#endif
+    }
+
+    void FlightRecorder::Enable(std::size_t recordsPerThread, const std::filesystem::path& dumpPath, uint32_t captureMask)
+    {
+        std::size_t expected = 0;
+        g_ringCapacity.compare_exchange_strong(expected, std::bit_ceil(std::max<std::size_t>(recordsPerThread, 16)));
+
+        g_dumpPath = dumpPath;
+        LogFilter::SetCaptureMask(captureMask);
+        s_enabled.store(true, std::memory_order_release);
+    }
+
+    void FlightRecorder::Disable()
+    {
+        s_enabled.store(false, std::memory_order_release);
+        LogFilter::SetCaptureMask(0);
+    }
+
+    FlightRecorder::ThreadRing* FlightRecorder::AcquireRing()
+    {
+        // ߳˳ʱ ring ȥһ̸߳
+        struct RingReleaser
+        {
+            ThreadRing* ring = nullptr;
+            ~RingReleaser()
+            {
+                if (ring)
+                    ring->inUse.store(false, std::memory_order_release);
+            }
+        };
+        static thread_local RingReleaser t_releaser;
+
+        const std::size_t capacity = g_ringCapacity.load(std::memory_order_acquire);
+        if (capacity == 0)
+            return nullptr;
+
+        ThreadRing* ring = nullptr;
+        for (ThreadRing* r = s_rings.load(std::memory_order_acquire); r; r = r->next)
+        {
+            bool expected = false;
+            if (r->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            {
+                ring = r;
+                break;
+            }
+        }
+
+        if (!ring)
+        {
+            // ring ͼ¼һڴ malloc  newڴ
+            void* memory = std::malloc(sizeof(ThreadRing) + sizeof(FlightRecord) * capacity);
+            if (!memory)
+                return nullptr;
+
+            ring = ::new (memory) ThreadRing();
+            ring->records = reinterpret_cast<FlightRecord*>(ring + 1);
+            for (std::size_t i = 0; i < capacity; ++i)
+            {
+                ::new (&ring->records[i]) FlightRecord();
+            }
+            ring->mask = capacity - 1;
+            ring->inUse.store(true, std::memory_order_relaxed);
+
+            ThreadRing* head = s_rings.load(std::memory_order_relaxed);
+            do
+            {
+                ring->next = head;
+            } while (!s_rings.compare_exchange_weak(head, ring, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        ring->threadId = CurrentThreadId();
+        t_releaser.ring = ring;
+        t_ring = ring;
+        return ring;
+    }
+
+    std::size_t FlightRecorder::Dump() noexcept
+    {
+        if (!s_enabled.load(std::memory_order_acquire) || g_dumping.exchange(true, std::memory_order_acq_rel))
+            return 0;
+
+        struct Cursor
+        {
+            ThreadRing* ring;
+            uint64_t next;
+            uint64_t end;
+        };
+        Cursor cursors[kMaxDumpThreads];
+        std::size_t cursorCount = 0;
+
+        for (ThreadRing* r = s_rings.load(std::memory_order_acquire); r && cursorCount < kMaxDumpThreads; r = r->next)
+        {
+            const uint64_t head = r->head.load(std::memory_order_acquire);
+            const uint64_t capacity = r->mask + 1;
+            if (head > 0)
+                cursors[cursorCount++] = Cursor{ r, head > capacity ? head - capacity : 0, head };
+        }
+
+        DumpWriter out(g_dumpPath);
+        if (!out.IsOpen())
+        {
+            g_dumping.store(false, std::memory_order_release);
+            return 0;
+        }
+
+        LogBinary::FileHeader header{};
+        std::memcpy(header.magic, LogBinary::kMagic, sizeof(header.magic));
+        header.version = LogBinary::kVersion;
+        out.Put(header);
+
+        std::fill(std::begin(g_dumpSites), std::end(g_dumpSites), nullptr);
+
+        // ߳ڲѾʱźÿȡʱһϲ
+        std::size_t written = 0;
+        bool anyThread = false;
+        uint32_t lastThreadId = 0;
+        for (;;)
+        {
+            Cursor* best = nullptr;
+            int64_t bestTimestamp = 0;
+            for (std::size_t i = 0; i < cursorCount; ++i)
+            {
+                Cursor& c = cursors[i];
+                while (c.next < c.end && c.ring->records[c.next & c.ring->mask].stamp.load(std::memory_order_acquire) != c.next + 1)
+                {
+                    ++c.next; // Ѿǻдһ룬
+                }
+                if (c.next == c.end)
+                    continue;
+
+                const int64_t timestamp = c.ring->records[c.next & c.ring->mask].timestamp;
+                if (!best || timestamp < bestTimestamp)
+                {
+                    best = &c;
+                    bestTimestamp = timestamp;
+                }
+            }
+            if (!best)
+                break;
+
+            const FlightRecord& source = best->ring->records[best->next & best->ring->mask];
+            FlightRecord snapshot;
+            snapshot.site = source.site;
+            snapshot.format = source.format;
+            snapshot.formatLength = source.formatLength;
+            snapshot.timestamp = source.timestamp;
+            snapshot.threadId = source.threadId;
+            snapshot.sequence = source.sequence;
+            snapshot.payloadLength = std::min<uint16_t>(source.payloadLength, static_cast<uint16_t>(kFlightRecordPayloadSize));
+            std::memcpy(snapshot.payload, source.payload, snapshot.payloadLength);
+
+            // ڼ䱻̸߳˾Ͷ
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const bool intact = source.stamp.load(std::memory_order_relaxed) == best->next + 1;
+            ++best->next;
+            if (!intact || !snapshot.site)
+                continue;
+
+            if (!anyThread || snapshot.threadId != lastThreadId)
+            {
+                out.Put(LogBinary::ChunkType::Thread);
+                out.Put(snapshot.threadId);
+                lastThreadId = snapshot.threadId;
+                anyThread = true;
+            }
+
+            const LogSite& site = *snapshot.site;
+            bool isNew = false;
+            const uint32_t siteId = DumpSiteId(&site, isNew);
+            if (isNew)
+            {
+                const std::string_view file = site.location.file_name();
+                const std::string_view func = Logger::ShortFunctionName(site.location.function_name());
+                const std::string_view format(snapshot.format ? snapshot.format : "", snapshot.formatLength);
+                out.Put(LogBinary::ChunkType::SiteDefinition);
+                out.Put(siteId);
+                out.Put(static_cast<uint8_t>(site.level));
+                out.Put(static_cast<uint32_t>(site.location.line()));
+                out.Put(static_cast<uint16_t>(file.size()));
+                out.Put(static_cast<uint16_t>(func.size()));
+                out.Put(static_cast<uint16_t>(format.size()));
+                out.Write(file.data(), file.size());
+                out.Write(func.data(), func.size());
+                out.Write(format.data(), format.size());
+            }
+
+            out.Put(LogBinary::ChunkType::Event);
+            out.Put(siteId);
+            out.Put(snapshot.sequence);
+            out.Put(snapshot.timestamp);
+            out.Put(snapshot.payloadLength);
+            out.Write(snapshot.payload, snapshot.payloadLength);
+            ++written;
+        }
+
+        g_dumping.store(false, std::memory_order_release);
+        return written;
+    }
+
+    void FlightRecorder::InstallCrashHandlers()
+    {
+        static std::once_flag once;
+        std::call_once(once, []
+            {
+                g_previousTerminate = std::set_terminate(&TerminateHandler);
+
+#ifdef _WIN32
+                g_previousFilter = SetUnhandledExceptionFilter(&UnhandledExceptionHandler);
+                std::signal(SIGABRT, &AbortSignalHandler);
+#else
+                stack_t stack{};
+                stack.ss_sp = g_signalStack;
+                stack.ss_size = sizeof(g_signalStack);
+                ::sigaltstack(&stack, nullptr);
+
+                struct sigaction action{};
+                action.sa_handler = &FatalSignalHandler;
+                action.sa_flags = SA_RESETHAND | SA_ONSTACK;
+                sigemptyset(&action.sa_mask);
+                for (const int sig : kFatalSignals)
+                {
+                    ::sigaction(sig, &action, nullptr);
+                }
+#endif
+            });
+    }
+} // namespace CBR::Engine::Debug
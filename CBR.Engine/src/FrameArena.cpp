@@ -0,0 +1,149 @@
+#include "pch.h"
+#include "Engine/Memory/FrameArena.h"
+#include "Engine/Memory/EngineHeap.h"
+#include "Engine/Debug/Logger.h"
+
+namespace CBR::Engine::Memory
+{
+	void* FrameArenaResource::do_allocate(std::size_t bytes, std::size_t alignment)
+	{
+		void* p = arena_.Allocate(bytes, alignment);
+		if (!p)
+			throw std::bad_alloc();
+		return p;
+	}
+
+	FrameArena::FrameArena(const char* name, std::size_t blockSize, std::size_t blockCount)
+		: name_(name)
+		, blockSize_(blockSize)
+	{
+		blocks_.reserve(blockCount);
+		for (std::size_t i = 0; i < blockCount; ++i)
+		{
+			// ֱӴĶѣϵͳãй©
+			unsigned char* memory = static_cast<unsigned char*>(EngineAlloc(blockSize_));
+			if (!memory)
+				break;
+			blocks_.push_back(Block{ memory, blockSize_ });
+			capacity_ += blockSize_;
+		}
+	}
+
+	FrameArena::~FrameArena()
+	{
+		for (const Block& block : blocks_)
+		{
+			EngineFree(block.memory);
+		}
+		for (const Block& block : oversized_)
+		{
+			EngineFree(block.memory);
+		}
+	}
+
+	void* FrameArena::Allocate(std::size_t size, std::size_t alignment) noexcept
+	{
+		assert(alignment != 0 && (alignment & (alignment - 1)) == 0 && "FrameArena: alignment must be a power of two");
+
+		if (size > blockSize_ || blockSize_ - size < alignment)
+		{
+			// һŲ£Ҫһ飬Reset ʱȥ
+			if (size > std::numeric_limits<std::size_t>::max() - alignment)
+				return nullptr;
+			unsigned char* memory = static_cast<unsigned char*>(EngineAlloc(size + alignment));
+			if (!memory)
+				return nullptr;
+			try
+			{
+				oversized_.push_back(Block{ memory, size + alignment });
+			}
+			catch (const std::bad_alloc&)
+			{
+				EngineFree(memory);
+				return nullptr;
+			}
+			usedBeforeCurrent_ += size;
+			overflowedThisFrame_ = true;
+			++overflowCount_;
+			const uintptr_t aligned = (reinterpret_cast<uintptr_t>(memory) + alignment - 1) & ~(uintptr_t{ alignment } - 1);
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		for (;;)
+		{
+			if (current_ < blocks_.size())
+			{
+				const Block& block = blocks_[current_];
+				const uintptr_t base = reinterpret_cast<uintptr_t>(block.memory);
+				const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(uintptr_t{ alignment } - 1);
+				if (aligned - base <= block.size - size)
+				{
+					offset_ = aligned - base + size;
+					return reinterpret_cast<void*>(aligned);
+				}
+			}
+			// ǰѾų˵Ųµһյģһŵ
+			if (!NextBlock())
+				return nullptr;
+		}
+	}
+
+	bool FrameArena::NextBlock() noexcept
+	{
+		if (current_ + 1 < blocks_.size())
+		{
+			usedBeforeCurrent_ += offset_;
+			offset_ = 0;
+			++current_;
+			return true;
+		}
+
+		// ԤĿˣһ鲢һֱһ֡Ͳ
+		unsigned char* memory = static_cast<unsigned char*>(EngineAlloc(blockSize_));
+		if (!memory)
+			return false;
+		try
+		{
+			blocks_.push_back(Block{ memory, blockSize_ });
+		}
+		catch (const std::bad_alloc&)
+		{
+			EngineFree(memory);
+			return false;
+		}
+
+		if (blocks_.size() > 1)
+		{
+			usedBeforeCurrent_ += offset_;
+			offset_ = 0;
+			overflowedThisFrame_ = true;
+			++overflowCount_;
+		}
+		current_ = blocks_.size() - 1;
+		capacity_ += blockSize_;
+		return true;
+	}
+
+	void FrameArena::Reset() noexcept
+	{
+		const std::size_t used = BytesUsed();
+		highWater_ = std::max<std::size_t>(highWater_, used);
+
+		if (overflowedThisFrame_)
+		{
+			CBR_LOG_LIMITED(Memory, Warn, 1, "[memory] FrameArena '{}' overflowed: {} bytes used this frame, capacity is now {} bytes in {} blocks.",
+				name_, used, capacity_, blocks_.size());
+		}
+
+		for (const Block& block : oversized_)
+		{
+			EngineFree(block.memory);
+		}
+		oversized_.clear();
+
+		current_ = 0;
+		offset_ = 0;
+		usedBeforeCurrent_ = 0;
+		overflowedThisFrame_ = false;
+	}
+} // namespace CBR::Engine::Memory
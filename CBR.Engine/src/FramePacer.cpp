@@ -0,0 +1,153 @@
+#include "pch.h"
+#include "Engine/Utility/FramePacer.h"
+#include "Engine/Utility/Clock.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace CBR::Engine::Utility
+{
+	namespace
+	{
+		inline void CpuRelax()
+		{
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+			_mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#else
+			std::this_thread::yield();
+#endif
+		}
+
+		// ˯Ĺֵÿ֡˥ 1/8ޣżһγĻӳ٣ռ֮һֱ
+		constexpr uint64_t kOversleepDecayShift = 3;
+		constexpr uint64_t kMaxOversleepEstimateNs = 2000000;
+	}
+
+	FramePacer::FramePacer()
+	{
+#ifdef _WIN32
+		// Windows 10 1803 ָ֧߾ȼʱҪ timeBeginPeriod
+		waitableTimer_ = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (!waitableTimer_)
+			waitableTimer_ = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+#endif
+	}
+
+	FramePacer::~FramePacer()
+	{
+#ifdef _WIN32
+		if (waitableTimer_)
+			CloseHandle(waitableTimer_);
+#endif
+	}
+
+	void FramePacer::SetTargetFrameRate(double framesPerSecond)
+	{
+		targetFrameRate_ = framesPerSecond > 0.0 ? framesPerSecond : 0.0;
+		periodTicks_ = targetFrameRate_ > 0.0 ? Clock::FromNanoseconds(static_cast<uint64_t>(1e9 / targetFrameRate_)) : 0;
+		nextDeadline_ = 0;
+	}
+
+	void FramePacer::WaitForNextFrame()
+	{
+		if (periodTicks_ == 0)
+			return;
+
+		++stats_.frames;
+		const uint64_t now = Clock::Now();
+		if (nextDeadline_ == 0)
+		{
+			nextDeadline_ = now + periodTicks_;
+			return;
+		}
+
+		const uint64_t deadline = nextDeadline_;
+		if (now >= deadline)
+		{
+			// һ֡Ѿʱ׷
+			++stats_.missedDeadlines;
+			nextDeadline_ = now + periodTicks_;
+			return;
+		}
+
+		// ˯ ֹʱ - 
+		const uint64_t marginTicks = Clock::FromNanoseconds(spinMarginNs_ + oversleepEstimateNs_);
+		if (deadline - now > marginTicks)
+		{
+			const uint64_t wakeTarget = deadline - marginTicks;
+			SleepUntil(wakeTarget);
+
+			const uint64_t woke = Clock::Now();
+			stats_.sleepNanoseconds += Clock::ToNanoseconds(woke - now);
+
+			//  = ʵʱ - ʱ
+			const uint64_t oversleepNs = woke > wakeTarget ? Clock::ToNanoseconds(woke - wakeTarget) : 0;
+			oversleepEstimateNs_ -= oversleepEstimateNs_ >> kOversleepDecayShift;
+			if (oversleepNs > oversleepEstimateNs_)
+				oversleepEstimateNs_ = oversleepNs < kMaxOversleepEstimateNs ? oversleepNs : kMaxOversleepEstimateNs;
+
+			if (woke > deadline)
+			{
+				const uint64_t lateNs = Clock::ToNanoseconds(woke - deadline);
+				++stats_.oversleepCount;
+				if (lateNs > stats_.maxOversleepNanoseconds)
+					stats_.maxOversleepNanoseconds = lateNs;
+			}
+		}
+
+		// ʣµʱ
+		const uint64_t spinStart = Clock::Now();
+		uint64_t current = spinStart;
+		while (current < deadline)
+		{
+			CpuRelax();
+			current = Clock::Now();
+		}
+		stats_.spinNanoseconds += Clock::ToNanoseconds(current - spinStart);
+
+		const uint64_t latenessNs = Clock::ToNanoseconds(current - deadline);
+		stats_.totalLatenessNanoseconds += latenessNs;
+		if (latenessNs > stats_.maxLatenessNanoseconds)
+			stats_.maxLatenessNanoseconds = latenessNs;
+
+		// һ֡Ľֹʱһ֡Ľֹʱ㣬֡ʲΪÿ֡СƯ
+		nextDeadline_ = deadline + periodTicks_;
+	}
+
+	void FramePacer::SleepUntil(uint64_t deadlineTicks)
+	{
+		const uint64_t now = Clock::Now();
+		if (deadlineTicks <= now)
+			return;
+		const uint64_t waitNs = Clock::ToNanoseconds(deadlineTicks - now);
+
+#ifdef _WIN32
+		if (waitableTimer_)
+		{
+			// ʾʱ䣬λ 100ns
+			LARGE_INTEGER dueTime;
+			dueTime.QuadPart = -static_cast<LONGLONG>(waitNs / 100);
+			if (SetWaitableTimer(waitableTimer_, &dueTime, 0, nullptr, nullptr, FALSE))
+			{
+				WaitForSingleObject(waitableTimer_, INFINITE);
+				return;
+			}
+		}
+		Sleep(static_cast<DWORD>(waitNs / 1000000));
+#else
+		timespec request;
+		request.tv_sec = static_cast<time_t>(waitNs / 1000000000ull);
+		request.tv_nsec = static_cast<long>(waitNs % 1000000000ull);
+		while (clock_nanosleep(CLOCK_MONOTONIC, 0, &request, &request) == EINTR)
+		{
+		}
+#endif
+	}
+}
@@ -0,0 +1,219 @@
+#include "pch.h"
+#include "Engine/Utility/FrameStats.h"
+
+namespace CBR::Engine::Utility
+{
+	namespace
+	{
+		// ƽȨأԼ 32 ֡
+		constexpr double kBaselineWeight = 1.0 / 32.0;
+
+		std::size_t HistogramBucket(double ms) noexcept
+		{
+			if (!(ms >= FrameStats::kHistogramBaseMs))
+				return 0;
+			const double octaves = std::log2(ms / FrameStats::kHistogramBaseMs);
+			const std::size_t bucket = 1 + static_cast<std::size_t>(octaves * FrameStats::kHistogramBucketsPerOctave);
+			return bucket < FrameStats::kHistogramBuckets ? bucket : FrameStats::kHistogramBuckets - 1;
+		}
+
+		// nearest-rank values ˳󼸸ٷλʱҪ¸
+		double Percentile(uint32_t* values, std::size_t count, double fraction) noexcept
+		{
+			std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(count)));
+			rank = rank == 0 ? 0 : rank - 1;
+			std::nth_element(values, values + rank, values + count);
+			return values[rank] * 1e-3;
+		}
+	}
+
+	void FrameStats::Record(uint64_t frame, double time, double deltaSeconds) noexcept
+	{
+		if (ignoreNext_.exchange(false, std::memory_order_relaxed))
+			return;
+
+		const double ms = deltaSeconds * 1e3;
+		const double us = deltaSeconds * 1e6;
+		const uint32_t durationUs = us >= static_cast<double>(UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(us + 0.5);
+
+		const uint64_t index = head_.load(std::memory_order_relaxed);
+		Sample& sample = samples_[index & (kCapacity - 1)];
+		sample.frame.store(frame, std::memory_order_relaxed);
+		sample.durationUs.store(durationUs, std::memory_order_relaxed);
+		head_.store(index + 1, std::memory_order_release);
+
+		histogram_[HistogramBucket(ms)].fetch_add(1, std::memory_order_relaxed);
+
+		// жøǰĻƽһ֡Լ̧߻׼
+		if (baselineMs_ > 0.0 && ms >= hitchConfig_.minimumMs && ms >= hitchConfig_.baselineFactor * baselineMs_)
+		{
+			const uint64_t hitch = hitchCount_.load(std::memory_order_relaxed);
+			HitchSlot& slot = hitches_[hitch % kMaxHitches];
+			slot.frame.store(frame, std::memory_order_relaxed);
+			slot.time.store(time, std::memory_order_relaxed);
+			slot.durationMs.store(ms, std::memory_order_relaxed);
+			slot.baselineMs.store(baselineMs_, std::memory_order_relaxed);
+			hitchCount_.store(hitch + 1, std::memory_order_release);
+		}
+
+		baselineMs_ = baselineMs_ > 0.0 ? baselineMs_ + (ms - baselineMs_) * kBaselineWeight : ms;
+	}
+
+	std::size_t FrameStats::CopyRecent(std::size_t count, uint32_t* durations, uint64_t* frames) const noexcept
+	{
+		const uint64_t head = head_.load(std::memory_order_acquire);
+		const std::size_t available = static_cast<std::size_t>(head < kCapacity ? head : kCapacity);
+		if (count == 0 || count > available)
+			count = available;
+
+		const uint64_t first = head - count;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const Sample& sample = samples_[(first + i) & (kCapacity - 1)];
+			durations[i] = sample.durationUs.load(std::memory_order_relaxed);
+			if (frames)
+				frames[i] = sample.frame.load(std::memory_order_relaxed);
+		}
+
+		// ڼд߳̿Ѿƻǰļ
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t after = head_.load(std::memory_order_relaxed);
+		const uint64_t oldestValid = after > kCapacity ? after - kCapacity : 0;
+		if (first >= oldestValid)
+			return count;
+
+		const std::size_t overwritten = static_cast<std::size_t>(oldestValid - first);
+		if (overwritten >= count)
+			return 0;
+		std::memmove(durations, durations + overwritten, (count - overwritten) * sizeof(uint32_t));
+		if (frames)
+			std::memmove(frames, frames + overwritten, (count - overwritten) * sizeof(uint64_t));
+		return count - overwritten;
+	}
+
+	FrameTimeSummary FrameStats::Summarize(std::size_t windowFrames) const noexcept
+	{
+		uint32_t durations[kCapacity];
+		FrameTimeSummary summary;
+		summary.frames = CopyRecent(windowFrames, durations, nullptr);
+		if (summary.frames == 0)
+			return summary;
+
+		uint64_t total = 0;
+		uint32_t maximum = 0;
+		for (std::size_t i = 0; i < summary.frames; ++i)
+		{
+			total += durations[i];
+			maximum = durations[i] > maximum ? durations[i] : maximum;
+		}
+		summary.averageMs = static_cast<double>(total) * 1e-3 / static_cast<double>(summary.frames);
+		summary.maxMs = maximum * 1e-3;
+		summary.p50Ms = Percentile(durations, summary.frames, 0.50);
+		summary.p95Ms = Percentile(durations, summary.frames, 0.95);
+		summary.p99Ms = Percentile(durations, summary.frames, 0.99);
+		return summary;
+	}
+
+	uint64_t FrameStats::HistogramCount(std::size_t bucket) const noexcept
+	{
+		return bucket < kHistogramBuckets ? histogram_[bucket].load(std::memory_order_relaxed) : 0;
+	}
+
+	double FrameStats::HistogramBucketLowerMs(std::size_t bucket) noexcept
+	{
+		if (bucket == 0)
+			return 0.0;
+		return kHistogramBaseMs * std::exp2(static_cast<double>(bucket - 1) / kHistogramBucketsPerOctave);
+	}
+
+	std::vector<FrameHitch> FrameStats::Hitches() const
+	{
+		const uint64_t count = hitchCount_.load(std::memory_order_acquire);
+		const uint64_t first = count > kMaxHitches ? count - kMaxHitches : 0;
+
+		std::vector<FrameHitch> hitches;
+		hitches.reserve(static_cast<std::size_t>(count - first));
+		for (uint64_t i = first; i < count; ++i)
+		{
+			const HitchSlot& slot = hitches_[i % kMaxHitches];
+			FrameHitch hitch;
+			hitch.frame = slot.frame.load(std::memory_order_relaxed);
+			hitch.time = slot.time.load(std::memory_order_relaxed);
+			hitch.durationMs = slot.durationMs.load(std::memory_order_relaxed);
+			hitch.baselineMs = slot.baselineMs.load(std::memory_order_relaxed);
+			hitches.push_back(hitch);
+		}
+		return hitches;
+	}
+
+	bool FrameStats::WriteCsv(const char* path) const
+	{
+		if (!path || !*path)
+			return false;
+
+		std::vector<uint32_t> durations(kCapacity);
+		std::vector<uint64_t> frames(kCapacity);
+		const std::size_t count = CopyRecent(0, durations.data(), frames.data());
+
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+			return false;
+
+		file << "frame,frame_ms\n";
+		file << std::fixed << std::setprecision(3);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			file << frames[i] << ',' << durations[i] * 1e-3 << '\n';
+		}
+		return static_cast<bool>(file);
+	}
+
+	bool FrameStats::WriteJson(const char* path) const
+	{
+		if (!path || !*path)
+			return false;
+
+		std::ofstream file(path, std::ios::trunc);
+		if (!file)
+			return false;
+
+		file << std::fixed << std::setprecision(3);
+		file << "{\n  \"frames\": " << head_.load(std::memory_order_acquire) << ",\n";
+
+		//  1 롢10 루 60 fps
+		constexpr std::size_t kWindows[] = { 60, 600, kCapacity };
+		file << "  \"windows\": [\n";
+		for (std::size_t i = 0; i < std::size(kWindows); ++i)
+		{
+			const FrameTimeSummary summary = Summarize(kWindows[i]);
+			file << "    { \"window\": " << kWindows[i] << ", \"frames\": " << summary.frames
+				<< ", \"avg_ms\": " << summary.averageMs << ", \"p50_ms\": " << summary.p50Ms << ", \"p95_ms\": " << summary.p95Ms
+				<< ", \"p99_ms\": " << summary.p99Ms << ", \"max_ms\": " << summary.maxMs << " }" << (i + 1 < std::size(kWindows) ? "," : "") << '\n';
+		}
+		file << "  ],\n";
+
+		file << "  \"histogram\": [\n";
+		bool first = true;
+		for (std::size_t bucket = 0; bucket < kHistogramBuckets; ++bucket)
+		{
+			const uint64_t count = HistogramCount(bucket);
+			if (count == 0)
+				continue;
+			file << (first ? "" : ",\n") << "    { \"lower_ms\": " << HistogramBucketLowerMs(bucket) << ", \"count\": " << count << " }";
+			first = false;
+		}
+		file << "\n  ],\n";
+
+		const std::vector<FrameHitch> hitches = Hitches();
+		file << "  \"hitch_count\": " << HitchCount() << ",\n";
+		file << "  \"hitches\": [\n";
+		for (std::size_t i = 0; i < hitches.size(); ++i)
+		{
+			const FrameHitch& hitch = hitches[i];
+			file << "    { \"frame\": " << hitch.frame << ", \"time_s\": " << hitch.time << ", \"ms\": " << hitch.durationMs
+				<< ", \"baseline_ms\": " << hitch.baselineMs << " }" << (i + 1 < hitches.size() ? "," : "") << '\n';
+		}
+		file << "  ]\n}\n";
+		return static_cast<bool>(file);
+	}
+}
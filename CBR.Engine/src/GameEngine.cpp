@@ -3,6 +3,17 @@
 #include "Engine/Configuration.h"
 #include "Engine/Application.h"
 #include "Engine/Utility/Timer.h"
+#include "Engine/Utility/FramePacer.h"
+#include "Engine/Utility/Scheduler.h"
+#include "Engine/Memory/FrameArena.h"
+#include "Engine/Memory/MemoryTagTracking.h"
+#include "Engine/Memory/NoAllocTracking.h"
+
+#include "Engine/Debug/Logger.h"
+#include "Engine/Debug/MemoryStats.h"
+#include "Engine/Debug/MemorySampler.h"
+#include "Engine/Debug/Profiler.h"
+#include "Engine/Utility/Environment.h"
 
 #if CBR_USE_DEBUG_MANAGER
 #include "Engine/Debug/DebugManager.h"
@@ -21,11 +32,76 @@ static bool initialized = false;
 using namespace CBR::Engine::Utility;
 // Ensure the static member is defined
 std::unique_ptr<Timer> CBR::Engine::GameEngine::timer_ = nullptr;
+std::unique_ptr<FramePacer> CBR::Engine::GameEngine::framePacer_ = nullptr;
+std::unique_ptr<Scheduler> CBR::Engine::GameEngine::scheduler_ = nullptr;
+std::unique_ptr<CBR::Engine::Memory::FrameArena> CBR::Engine::GameEngine::frameArena_ = nullptr;
+std::unique_ptr<CBR::Engine::Memory::DoubleBufferedFrameArena> CBR::Engine::GameEngine::doubleBufferedFrameArena_ = nullptr;
+
+// ֡ڷĳʼʱԶӿ鲢־ʾ
+static constexpr std::size_t kFrameArenaBlockSize = 1024 * 1024;
+static constexpr std::size_t kFrameArenaBlockCount = 4;
+static constexpr std::size_t kDoubleBufferedFrameArenaBlockCount = 1;
+
+// Ĭ֡ޣCBR_TARGET_FPS Ըǣ0 Ϊƣ
+static constexpr double kDefaultTargetFrameRate = 60.0;
+
+// ǰ֡ڴԴ仺棬֡ڷ
+static constexpr uint64_t kNoAllocWarmupFrames = 60;
+static uint64_t iterationCount = 0;
 
 namespace CBR::Engine
 {
 	bool GameEngine::Initialize()
 	{
+		// ־ReleaseҲЧȶȡ
+		Debug::LogFilter::LoadConfiguration();
+		Memory::LoadMemoryBudgets();
+		Memory::LoadNoAllocMode();
+
+		Memory::MemoryTagScope memoryTag(Memory::MemoryTag::Engine);
+
+		// ־ͱ¼ DebugManagerRelease µֵزͬҪ
+		Debug::Logger& logger = Debug::GetLogger();
+
+		// ̨֮ļCBR_LOG_FILE / CBR_LOG_MAPPED
+		logger.ConfigureSinksFromEnvironment();
+
+		// м¼ÿ̱߳ļ¼˵ DEBUGʱд CBR_FLIGHT_RECORDER_FILEĬ cbr_crash.cbrlog
+		// CBR_FLIGHT_RECORDER=0 رգÿ̱߳
+		if (const std::string recorder = ReadEnvironmentVariable("CBR_FLIGHT_RECORDER"); recorder != "0")
+		{
+			const std::size_t records = recorder.empty() ? Debug::FlightRecorder::kDefaultRecordsPerThread : static_cast<std::size_t>(std::max<int>(1, std::atoi(recorder.c_str())));
+			std::string dumpPath = ReadEnvironmentVariable("CBR_FLIGHT_RECORDER_FILE");
+			if (dumpPath.empty())
+				dumpPath = "cbr_crash.cbrlog";
+
+			Debug::FlightRecorder::Enable(records, dumpPath, Debug::LogFilter::kAllLevels);
+			Debug::FlightRecorder::InstallCrashHandlers();
+		}
+
+		// ־ĸʽͿ̨дֻ̣߳߳
+		logger.StartAsync(Debug::AsyncLogConfig{ .capacity = 4096, .overflowPolicy = Debug::LogOverflowPolicy::Block });
+
+		//  CBR_LOG_BINARY=<path> ʱл־ CBR.LogDecoder 鿴
+		if (const std::string binaryPath = ReadEnvironmentVariable("CBR_LOG_BINARY"); !binaryPath.empty())
+		{
+			logger.OpenBinaryLog(binaryPath);
+		}
+
+		// CBR_PROFILE=<path>¼ CBR_PROFILE_SCOPEShutdown ʱд Chrome Trace JSON ־ÿ֡ƽʱ
+		if (!ReadEnvironmentVariable("CBR_PROFILE").empty())
+		{
+			Debug::Profiler::Start();
+		}
+
+		// ReleaseҲЧCBR_HEAP_SAMPLE_INTERVAL=<ƽֽڣ>Shutdown ʱд CBR_HEAP_SAMPLE_FILE
+		if (const std::string interval = ReadEnvironmentVariable("CBR_HEAP_SAMPLE_INTERVAL"); !interval.empty())
+		{
+			Debug::mlt::SamplerConfig config;
+			config.sampleIntervalBytes = static_cast<std::size_t>(std::strtoull(interval.c_str(), nullptr, 10));
+			Debug::mlt::StartSampling(config);
+		}
+
 		// initializerfinalizerΪManagerĳʼ͹رպָ
 		const struct
 		{
@@ -50,13 +126,38 @@ namespace CBR::Engine
 			}
 		}
 
-		// timer
+		// timerģƵʿ CBR_FIXED_STEP_RATE=<ÿ벽> ǣĬ 60
 		timer_ = std::make_unique<Timer>();
+		if (const std::string stepRate = ReadEnvironmentVariable("CBR_FIXED_STEP_RATE"); !stepRate.empty())
+		{
+			const double rate = std::strtod(stepRate.c_str(), nullptr);
+			if (rate > 0.0)
+				timer_->SetFixedStepRate(rate);
+			else
+				CBR_LOG(Engine, Warn, "Ignoring invalid CBR_FIXED_STEP_RATE '{}'.", stepRate);
+		}
+
+		scheduler_ = std::make_unique<Scheduler>();
+
+		framePacer_ = std::make_unique<FramePacer>();
+		double targetFrameRate = kDefaultTargetFrameRate;
+		if (const std::string targetFps = ReadEnvironmentVariable("CBR_TARGET_FPS"); !targetFps.empty())
+		{
+			targetFrameRate = std::strtod(targetFps.c_str(), nullptr);
+		}
+		framePacer_->SetTargetFrameRate(targetFrameRate);
+
+		// ֡ڷҪApplicationʼ֮ǰʼʱͿʹ
+		frameArena_ = std::make_unique<Memory::FrameArena>("Frame", kFrameArenaBlockSize, kFrameArenaBlockCount);
+		doubleBufferedFrameArena_ = std::make_unique<Memory::DoubleBufferedFrameArena>("DoubleBufferedFrame", kFrameArenaBlockSize, kDoubleBufferedFrameArenaBlockCount);
 
 		// ʼCBRGameʵ
-		if (!Application::GetInstance()->Initialize())
 		{
-			return false;
+			Memory::MemoryTagScope gameTag(Memory::MemoryTag::Game);
+			if (!Application::GetInstance()->Initialize())
+			{
+				return false;
+			}
 		}
 
 		LOG_INFO("CBR engine initialized Successfully!");
@@ -65,30 +166,142 @@ namespace CBR::Engine
 		return true;
 	}
 
-	bool GameEngine::Iteration()
+	bool GameEngine::Iteration(bool render)
 	{
-		// SceneUpdate
+		Debug::Profiler::BeginFrame(timer_->FrameIndex() + 1);
+		{
+			// ȶʱ֡ڲӦжѷ䣨CBR_NOALLOC=1/2 ʱ飩
+			Memory::NoAllocScope noAlloc("GameEngine::Iteration", iterationCount++ >= kNoAllocWarmupFrames);
+
+			// һ֡ڵʱ䣬̶ۻһ֡Ҫִеģⲽ
+			timer_->Tick();
 
-		// Render
-		Graphics::Renderer::BeginFrame();
-		Graphics::Renderer::Render();
-		Graphics::Renderer::EndFrame();
+			Application* application = Application::GetInstance();
+			{
+				Memory::MemoryTagScope gameTag(Memory::MemoryTag::Game);
 
-		if (timer_)
+				// һ֡ڵĶʱصϷʱ TimeScale Ӱ죩
+				{
+					CBR_PROFILE_SCOPE("Scheduler::Advance");
+					scheduler_->Advance(timer_->RawDeltaTime(), timer_->DeltaTime());
+				}
+
+				for (uint32_t step = 0; step < timer_->FixedStepCount(); ++step)
+				{
+					CBR_PROFILE_SCOPE("Application::FixedUpdate");
+					application->FixedUpdate(timer_->FixedDeltaTime());
+				}
+				CBR_PROFILE_SCOPE("Application::Update");
+				application->Update(timer_->DeltaTime(), timer_->InterpolationAlpha());
+			}
+
+			// Renderһ͵ǰģⲽֵ֮
+			if (render)
+			{
+				Graphics::Renderer::BeginFrame();
+				Graphics::Renderer::Render(static_cast<float>(timer_->InterpolationAlpha()));
+				Graphics::Renderer::EndFrame();
+			}
+		}
+
+		// ߽֡磺ͳһ֡ķmlt::EndFrame ReleaseΪպ
+		Debug::mlt::EndFrame();
+		Memory::EndNoAllocFrame();
+		Memory::CheckMemoryBudgets();
+
+		// һ֡ʱݣ˫Ǹһ֡
+		frameArena_->Reset();
+		doubleBufferedFrameArena_->Swap();
+
+		// ȵһ֡Ľֹʱ䣬֡ʱֱӷ
 		{
-			timer_->Tick();
+			CBR_PROFILE_SCOPE("FramePacer::WaitForNextFrame");
+			framePacer_->WaitForNextFrame();
 		}
+		Debug::Profiler::EndFrame();
 		
 		return true;
 	}
 
 	void GameEngine::Shutdown()
 	{
+		// ͷų֮ǰдӳеĶ
+		if (Debug::mlt::IsSampling())
+		{
+			std::string profilePath = ReadEnvironmentVariable("CBR_HEAP_SAMPLE_FILE");
+			if (profilePath.empty())
+				profilePath = "cbr_heap_profile.txt";
+			Debug::mlt::WriteSampledProfile(profilePath.c_str());
+			Debug::mlt::StopSampling();
+		}
+
+		if (Memory::GetNoAllocMode() != Memory::NoAllocMode::Off)
+		{
+			const uint64_t violations = Memory::GetNoAllocViolationCount();
+			std::string reportPath = ReadEnvironmentVariable("CBR_NOALLOC_REPORT");
+			if (reportPath.empty())
+				reportPath = "cbr_noalloc_report.txt";
+			Memory::WriteNoAllocReport(reportPath.c_str());
+			if (violations != 0)
+				CBR_LOG(Memory, Error, "[memory] {} heap allocations inside no-alloc regions, see {}.", violations, reportPath);
+			else
+				CBR_LOG(Memory, Info, "[memory] No heap allocations inside no-alloc regions.");
+		}
+
+		if (Debug::Profiler::IsEnabled())
+		{
+			Debug::Profiler::Stop();
+			const std::string tracePath = ReadEnvironmentVariable("CBR_PROFILE");
+			if (!Debug::Profiler::WriteChromeTrace(tracePath.c_str()))
+				CBR_LOG(Engine, Warn, "Failed to write profiler trace to {}.", tracePath);
+
+			for (const Debug::ProfileNodeSummary& node : Debug::Profiler::GetAverageFrameSummary())
+			{
+				CBR_LOG(Engine, Info, "[profile] {:>{}}{}: {:.3f} ms/frame, {:.1f} calls/frame", "", node.depth * 2, node.name, node.milliseconds, node.calls);
+			}
+		}
+
+		// ֡ʱͳƣ־İٷλCBR_FRAME_STATS=<path>.json  .csvʱдļȽϲͬ
+		if (timer_)
+		{
+			const FrameStats& frameStats = timer_->GetFrameStats();
+			const FrameTimeSummary summary = frameStats.Summarize(0);
+			if (summary.frames != 0)
+			{
+				CBR_LOG(Engine, Info, "Frame times over last {} frames: avg {:.2f} ms, p50 {:.2f} ms, p95 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms, {} hitches.",
+					summary.frames, summary.averageMs, summary.p50Ms, summary.p95Ms, summary.p99Ms, summary.maxMs, frameStats.HitchCount());
+			}
+
+			if (const std::string statsPath = ReadEnvironmentVariable("CBR_FRAME_STATS"); !statsPath.empty())
+			{
+				const bool json = std::filesystem::path(statsPath).extension() == ".json";
+				if (!(json ? frameStats.WriteJson(statsPath.c_str()) : frameStats.WriteCsv(statsPath.c_str())))
+					CBR_LOG(Engine, Warn, "Failed to write frame statistics to {}.", statsPath);
+			}
+		}
+
+		if (framePacer_ && framePacer_->TargetFrameRate() > 0.0)
+		{
+			const FramePacerStats& pacing = framePacer_->Stats();
+			const uint64_t paced = pacing.frames - pacing.missedDeadlines;
+			CBR_LOG(Engine, Info, "Frame pacing at {:.1f} fps: {} frames, {} missed, {} overslept (max {:.3f} ms), average error {:.3f} ms (max {:.3f} ms), spin {:.1f} ms total.",
+				framePacer_->TargetFrameRate(), pacing.frames, pacing.missedDeadlines, pacing.oversleepCount, pacing.maxOversleepNanoseconds * 1e-6,
+				paced ? pacing.totalLatenessNanoseconds * 1e-6 / paced : 0.0, pacing.maxLatenessNanoseconds * 1e-6, pacing.spinNanoseconds * 1e-6);
+		}
+
 		// ճʼ˳shutdown
-		Application::GetInstance()->Shotdowm();
-		Application::DestroyInstance();
+		{
+			Memory::MemoryTagScope gameTag(Memory::MemoryTag::Game);
+			Application::GetInstance()->Shotdowm();
+			// صϷ Application ǰͷ
+			scheduler_.reset();
+			Application::DestroyInstance();
+		}
 
+		framePacer_.reset();
 		timer_.reset();
+		doubleBufferedFrameArena_.reset();
+		frameArena_.reset();
 
 		for (const auto& finalizer : finalizers | std::views::reverse)
 		{
@@ -96,12 +309,46 @@ namespace CBR::Engine
 		}
 		finalizers.clear();
 
+		// ֮LOGصͬģʽ
+		Debug::GetLogger().Flush();
+		Debug::GetLogger().StopAsync();
+
 		LOG_INFO("CBR engine Shutdown!");
 
 		LOG_INFO("Press Enter to exit...");
 		std::cin.get();
 	}
 
+	Memory::FrameArena& GameEngine::GetFrameArena()
+	{
+		assert(frameArena_ && "GameEngine::GetFrameArena called outside Initialize/Shutdown");
+		return *frameArena_;
+	}
+
+	Memory::DoubleBufferedFrameArena& GameEngine::GetDoubleBufferedFrameArena()
+	{
+		assert(doubleBufferedFrameArena_ && "GameEngine::GetDoubleBufferedFrameArena called outside Initialize/Shutdown");
+		return *doubleBufferedFrameArena_;
+	}
+
+	Timer& GameEngine::GetTimer()
+	{
+		assert(timer_ && "GameEngine::GetTimer called outside Initialize/Shutdown");
+		return *timer_;
+	}
+
+	FramePacer& GameEngine::GetFramePacer()
+	{
+		assert(framePacer_ && "GameEngine::GetFramePacer called outside Initialize/Shutdown");
+		return *framePacer_;
+	}
+
+	Scheduler& GameEngine::GetScheduler()
+	{
+		assert(scheduler_ && "GameEngine::GetScheduler called outside Initialize/Shutdown");
+		return *scheduler_;
+	}
+
 	bool GameEngine::IsInitialized()
 	{
 		return initialized;
@@ -0,0 +1,132 @@
+#include "pch.h"
+#include "Engine/Debug/Logger.h"
+#include "Engine/Utility/Environment.h"
+
+namespace CBR::Engine::Debug
+{
+    namespace
+    {
+        // س̶ȴӵ͵ߣֵϵļȫ
+        constexpr LogLevel::Value kSeverityOrder[] = {
+            LogLevel::Value::Debug,
+            LogLevel::Value::Info,
+            LogLevel::Value::Warn,
+            LogLevel::Value::Error,
+        };
+
+        uint32_t MaskFromMinimumLevel(LogLevel::Value level) noexcept
+        {
+            uint32_t mask = 0;
+            bool reached = false;
+            for (const LogLevel::Value v : kSeverityOrder)
+            {
+                reached = reached || (v == level);
+                if (reached)
+                    mask |= LogFilter::LevelBit(v);
+            }
+            return mask;
+        }
+
+        std::optional<uint32_t> ParseLevelMask(std::string_view text) noexcept
+        {
+            if (Utility::EqualsIgnoreCase(text, "Off") || Utility::EqualsIgnoreCase(text, "None"))
+                return 0u;
+            if (Utility::EqualsIgnoreCase(text, "All"))
+                return LogFilter::kAllLevels;
+
+            for (const LogLevel::Value v : kSeverityOrder)
+            {
+                if (Utility::EqualsIgnoreCase(text, LogLevel(v).ToString()))
+                    return MaskFromMinimumLevel(v);
+            }
+            return std::nullopt;
+        }
+    }
+
+    void LogFilter::UpdateMask(std::size_t index) noexcept
+    {
+        const uint32_t mask = s_sinkMasks[index].load(std::memory_order_relaxed) | s_captureMask.load(std::memory_order_relaxed);
+        s_masks[index].store(mask, std::memory_order_relaxed);
+    }
+
+    void LogFilter::SetCaptureMask(uint32_t mask) noexcept
+    {
+        s_captureMask.store(mask & kAllLevels, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < static_cast<std::size_t>(LogCategory::Count); ++i)
+        {
+            UpdateMask(i);
+        }
+    }
+
+    void LogFilter::SetMask(LogCategory category, uint32_t mask) noexcept
+    {
+        const std::size_t index = static_cast<std::size_t>(category);
+        s_sinkMasks[index].store(mask & kAllLevels, std::memory_order_relaxed);
+        UpdateMask(index);
+    }
+
+    void LogFilter::SetMinimumLevel(LogCategory category, LogLevel::Value level) noexcept
+    {
+        SetMask(category, MaskFromMinimumLevel(level));
+    }
+
+    void LogFilter::SetMinimumLevelAll(LogLevel::Value level) noexcept
+    {
+        for (std::size_t i = 0; i < static_cast<std::size_t>(LogCategory::Count); ++i)
+        {
+            SetMinimumLevel(static_cast<LogCategory>(i), level);
+        }
+    }
+
+    uint32_t LogFilter::GetMask(LogCategory category) noexcept
+    {
+        return s_sinkMasks[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    int LogFilter::Configure(std::string_view spec)
+    {
+        return Utility::ForEachSpecEntry(spec, [](std::string_view name, std::string_view value) {
+            const std::optional<uint32_t> mask = ParseLevelMask(value);
+            if (!mask)
+                return false;
+
+            if (name == "*")
+            {
+                for (std::size_t i = 0; i < static_cast<std::size_t>(LogCategory::Count); ++i)
+                    SetMask(static_cast<LogCategory>(i), *mask);
+                return true;
+            }
+
+            for (std::size_t i = 0; i < static_cast<std::size_t>(LogCategory::Count); ++i)
+            {
+                const LogCategory category = static_cast<LogCategory>(i);
+                if (Utility::EqualsIgnoreCase(name, ToString(category)))
+                {
+                    SetMask(category, *mask);
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+    void LogFilter::LoadConfiguration()
+    {
+        std::string path = Utility::ReadEnvironmentVariable("CBR_LOG_CONFIG");
+        if (path.empty())
+            path = "cbr_log.cfg";
+
+        if (std::ifstream file(path); file)
+        {
+            std::ostringstream content;
+            content << file.rdbuf();
+            Configure(content.str());
+        }
+
+        // ļ
+        if (const std::string levels = Utility::ReadEnvironmentVariable("CBR_LOG_LEVELS"); !levels.empty())
+        {
+            Configure(levels);
+        }
+    }
+} // namespace CBR::Engine::Debug
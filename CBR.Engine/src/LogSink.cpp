@@ -0,0 +1,470 @@
+#include "pch.h"
+#include "Engine/Debug/LogSink.h"
+#include "Engine/Debug/Logger.h"
+
+namespace CBR::Engine::Debug
+{
+    namespace
+    {
+        // ضϵϢӵı
+        constexpr std::string_view kTruncationMarker = "...";
+
+        struct ColorGuard {
+#ifdef _WIN32
+            HANDLE h{};
+            WORD   restore{};
+            ColorGuard(HANDLE hConsole, WORD color, WORD restoreAttr) : h(hConsole), restore(restoreAttr) {
+                if (h) SetConsoleTextAttribute(h, color);
+            }
+            ~ColorGuard() { if (h) SetConsoleTextAttribute(h, restore); }
+#else
+            std::string reset = "\x1b[0m";
+            ColorGuard(const char* colorSeq) { std::fputs(colorSeq, stdout); }
+            ~ColorGuard() { std::fputs(reset.c_str(), stdout); }
+#endif
+        };
+    }
+
+    // ============================== ConsoleLogSink ==============================
+
+    ConsoleLogSink::ConsoleLogSink(bool openDebugConsole)
+    {
+#ifdef _WIN32
+        if (openDebugConsole)
+        {
+            // ̨
+            OpenDebugConsole();
+        }
+
+        // ǫ̃
+        hConsole_ = GetStdHandle(STD_OUTPUT_HANDLE);
+
+        CONSOLE_SCREEN_BUFFER_INFO info{};
+        if (hConsole_ && GetConsoleScreenBufferInfo(hConsole_, &info)) {
+            defaultAttr_ = info.wAttributes;
+        }
+#else
+        (void)openDebugConsole;
+#endif // _WIN32
+    }
+
+    ConsoleLogSink::~ConsoleLogSink()
+    {
+#ifdef _WIN32
+        // رտ̨
+        if (ownsConsole_)
+            FreeConsole();
+#endif // _WIN32
+    }
+
+    void ConsoleLogSink::Write(const LogRecord& record, std::string_view header, std::string_view message)
+    {
+        const LogLevel level(record.level);
+
+#ifdef _WIN32
+        ColorGuard cg(hConsole_, level.ToColor(), defaultAttr_);
+#else
+        //  ANSI ӳ䣨ʾ⣩
+        const char* seq = "\x1b[37m";
+        switch (level.value) {
+        case LogLevel::Value::Info:  seq = "\x1b[92m"; break; // 
+        case LogLevel::Value::Warn:  seq = "\x1b[93m"; break; // 
+        case LogLevel::Value::Error: seq = "\x1b[91m"; break; // 
+        case LogLevel::Value::Debug: seq = "\x1b[96m"; break; // 
+        }
+        ColorGuard cg(seq);
+#endif // _WIN32
+
+        std::size_t windowWidth = kConsoleWindowWidth;
+#ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO csbi{};
+        if (hConsole_ && GetConsoleScreenBufferInfo(hConsole_, &csbi)) {
+            windowWidth = static_cast<std::size_t>(csbi.srWindow.Right - csbi.srWindow.Left + 1);
+        }
+        if (windowWidth == 0) windowWidth = kConsoleWindowWidth;
+#endif
+
+        //  header header ڿȣҲڿУ
+        std::ostringstream out;
+
+        auto WriteWrapped = [&](std::string_view text, std::size_t indentSpaces)
+            {
+                const std::string indent(indentSpaces, ' ');
+
+                // һв
+                bool first = true;
+
+                while (!text.empty())
+                {
+                    if (!first) out << indent;
+
+                    const std::size_t usableWidth =
+                        (windowWidth > indentSpaces) ? (windowWidth - indentSpaces) : 1;
+
+                    const std::size_t len = std::min<std::size_t>(text.size(), usableWidth);
+                    out << text.substr(0, len) << '\n';
+                    text.remove_prefix(len);
+
+                    first = false;
+                }
+            };
+
+        // headerУindent=0
+        if (!header.empty())
+            WriteWrapped(header, 0);
+        else
+            out << '\n';
+
+        //  message
+        constexpr std::size_t kMessageIndent = 0; // ڶ
+
+        if (message.empty()) {
+            out << std::string(kMessageIndent, ' ') << '\n';
+        }
+        else if (record.truncated) {
+            // ضϱǺһ
+            WriteWrapped(std::string(message).append(kTruncationMarker), kMessageIndent);
+        }
+        else {
+            // message һпʼ kMessageIndent
+            // ζſÿ = windowWidth - kMessageIndent
+            WriteWrapped(message, kMessageIndent);
+        }
+
+        std::string finalText = out.str();
+        finalText += '\n';
+
+#ifdef _WIN32
+        std::wstring wtext = AnsiToUtf16(finalText);
+        DWORD written = 0;
+        if (!WriteConsoleW(hConsole_, wtext.c_str(), (DWORD)wtext.size(), &written, nullptr))
+        {
+            std::cout << finalText;
+        }
+
+        // ͬ
+        OutputDebugStringW(wtext.c_str());
+#else
+        std::cout << finalText;
+#endif // _WIN32
+    }
+
+    void ConsoleLogSink::Flush()
+    {
+        std::cout.flush();
+    }
+
+#ifdef _WIN32
+    std::wstring ConsoleLogSink::AnsiToUtf16(std::string_view s)
+    {
+        if (s.empty()) return {};
+        constexpr UINT kCodePage = CP_ACP;
+
+        int wlen = MultiByteToWideChar(kCodePage, 0, s.data(), (int)s.size(), nullptr, 0);
+        if (wlen <= 0) return {};
+
+        std::wstring w(wlen, L'\0');
+        MultiByteToWideChar(kCodePage, 0, s.data(), (int)s.size(), w.data(), wlen);
+        return w;
+    }
+
+    void ConsoleLogSink::OpenDebugConsole()
+    {
+        // ̨븴ø̨̿ AttachConsole(ATTACH_PARENT_PROCESS)
+        ownsConsole_ = AllocConsole() != FALSE;
+        SetConsoleOutputCP(CP_UTF8);
+        SetConsoleCP(CP_UTF8);
+
+        //  C/CPP ׼ָ̨
+        FILE* fp;
+        freopen_s(&fp, "CONOUT$", "w", stdout);
+        freopen_s(&fp, "CONOUT$", "w", stderr);
+        freopen_s(&fp, "CONIN$", "r", stdin);
+
+        // UTF-8 
+        SetConsoleOutputCP(CP_UTF8);
+
+        // ȡ׼
+        HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+
+        // ûС
+        COORD bufferSize;
+        bufferSize.X = 400;
+        bufferSize.Y = 2000;
+        SetConsoleScreenBufferSize(hOut, bufferSize);
+
+        // ôڿɼĴС벻 bufferSize
+        SMALL_RECT windowRect;
+        windowRect.Left = 0;
+        windowRect.Top = 0;
+        windowRect.Right = kConsoleWindowWidth - 1;          //  = Right - Left + 1
+        windowRect.Bottom = kConsoleWindowHeight - 1; // ɼԼϲод-1
+        SetConsoleWindowInfo(hOut, TRUE, &windowRect);
+
+        // áβԶС
+        DWORD mode = 0;
+        if (GetConsoleMode(hOut, &mode))
+        {
+            mode &= ~ENABLE_WRAP_AT_EOL_OUTPUT;  //  wrap
+            SetConsoleMode(hOut, mode);
+        }
+
+        // øı䴰ڴС
+        HWND hwndConsole = GetConsoleWindow();
+        if (hwndConsole)
+        {
+            // ȥɵС߿(ק)󻯰ť
+            LONG style = GetWindowLong(hwndConsole, GWL_STYLE);
+            style &= ~WS_THICKFRAME;   // ֹק߿С
+            style &= ~WS_MAXIMIZEBOX;  // ֹ
+            SetWindowLong(hwndConsole, GWL_STYLE, style);
+
+            // ҵϵͳ˵ Size/Maximize
+            HMENU hMenu = GetSystemMenu(hwndConsole, FALSE);
+            if (hMenu)
+            {
+                EnableMenuItem(hMenu, SC_SIZE, MF_BYCOMMAND | MF_GRAYED);
+                EnableMenuItem(hMenu, SC_MAXIMIZE, MF_BYCOMMAND | MF_GRAYED);
+            }
+
+            // ʽЧ
+            SetWindowPos(hwndConsole, nullptr, 0, 0, 0, 0,
+                SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED);
+        }
+    }
+#endif // _WIN32
+
+    // ============================== FileLogSink ==============================
+
+    FileLogSink::FileLogSink(const std::filesystem::path& path, bool append)
+        : file_(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc))
+    {
+    }
+
+    void FileLogSink::Write(const LogRecord& record, std::string_view header, std::string_view message)
+    {
+        if (!file_.is_open())
+            return;
+
+        //  CBR.LogDecoder һ£ڿ
+        file_ << header << '\n' << message;
+        if (record.truncated)
+            file_ << kTruncationMarker;
+        file_ << "\n\n";
+
+        // Error ͨű˳
+        if (record.level == LogLevel::Value::Error)
+            file_.flush();
+    }
+
+    void FileLogSink::Flush()
+    {
+        if (file_.is_open())
+            file_.flush();
+    }
+
+    // ============================== MappedRotatingFileSink ==============================
+
+    MappedRotatingFileSink::MappedRotatingFileSink(const MappedLogConfig& config)
+        : config_(config)
+    {
+        // ֶҪŵһ¼
+        config_.segmentSize = std::max<std::size_t>(config_.segmentSize, 64 * 1024);
+        ContinueNumbering();
+        OpenSegment(Utility::Clock::SystemNow());
+    }
+
+    MappedRotatingFileSink::~MappedRotatingFileSink()
+    {
+        CloseSegment();
+    }
+
+    void MappedRotatingFileSink::Write(const LogRecord& record, std::string_view header, std::string_view message)
+    {
+        if (!view_)
+            return;
+
+        const std::string_view marker = record.truncated ? kTruncationMarker : std::string_view();
+        const std::size_t needed = header.size() + message.size() + marker.size() + 3;
+        const bool full = offset_ + needed > config_.segmentSize;
+        const bool expired = config_.rollInterval.count() > 0 && record.timestamp - segmentStart_ >= config_.rollInterval;
+        if ((full || expired) && offset_ > 0)
+        {
+            CloseSegment();
+            ++segmentIndex_;
+            if (!OpenSegment(record.timestamp))
+                return;
+        }
+
+        Append(header);
+        Append("\n");
+        Append(message);
+        Append(marker);
+        Append("\n\n");
+    }
+
+    void MappedRotatingFileSink::Append(std::string_view text) noexcept
+    {
+        // һֶλļ¼ֻŵµĲ
+        const std::size_t length = std::min<std::size_t>(text.size(), config_.segmentSize - offset_);
+        std::memcpy(view_ + offset_, text.data(), length);
+        offset_ += length;
+    }
+
+    std::filesystem::path MappedRotatingFileSink::SegmentPath(uint32_t index) const
+    {
+        std::filesystem::path path = config_.basePath;
+        path += std::format("_{}.log", index);
+        return path;
+    }
+
+    void MappedRotatingFileSink::ContinueNumbering()
+    {
+        // һедǱǰ־ maxSegments ľɷֶΣ缸µģһɾ
+        std::vector<uint32_t> existing;
+        try
+        {
+            const std::filesystem::path directory = config_.basePath.has_parent_path() ? config_.basePath.parent_path() : std::filesystem::path(".");
+            const std::string prefix = config_.basePath.filename().string() + "_";
+            constexpr std::string_view extension = ".log";
+
+            std::error_code ec;
+            for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec))
+            {
+                const std::string name = it->path().filename().string();
+                if (name.size() <= prefix.size() + extension.size() || !name.starts_with(prefix) || !name.ends_with(extension))
+                    continue;
+
+                const char* first = name.data() + prefix.size();
+                const char* last = name.data() + name.size() - extension.size();
+                uint32_t index = 0;
+                const auto [ptr, error] = std::from_chars(first, last, index);
+                if (error == std::errc() && ptr == last)
+                    existing.push_back(index);
+            }
+        }
+        catch (const std::exception&)
+        {
+            // Ŀ¼ˣļ޷תʱûоɷֶ
+        }
+
+        if (existing.empty())
+            return;
+
+        segmentIndex_ = *std::max_element(existing.begin(), existing.end()) + 1;
+        if (config_.maxSegments == 0)
+            return;
+
+        // ·ֶδ򿪺 [segmentIndex_ - maxSegments + 1, segmentIndex_]
+        std::error_code ec;
+        for (const uint32_t index : existing)
+        {
+            if (static_cast<uint64_t>(index) + config_.maxSegments <= segmentIndex_)
+                std::filesystem::remove(SegmentPath(index), ec);
+        }
+    }
+
+    bool MappedRotatingFileSink::OpenSegment(std::chrono::system_clock::time_point now)
+    {
+        const std::filesystem::path path = SegmentPath(segmentIndex_);
+        const std::size_t size = config_.segmentSize;
+
+#ifdef _WIN32
+        file_ = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+            return false;
+
+        // ӳСļʱ CreateFileMapping ļչȣ൱Ԥ
+        const uint64_t size64 = size;
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READWRITE, static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFF), nullptr);
+        if (mapping_)
+            view_ = static_cast<char*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, size));
+
+        if (!view_)
+        {
+            if (mapping_) CloseHandle(mapping_);
+            CloseHandle(file_);
+            mapping_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+            return false;
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0)
+            return false;
+
+        // ̿飬дӳҳʱŷִSIGBUSֵ֧ļϵͳ˻ص ftruncate
+        if (::posix_fallocate(fd_, 0, static_cast<off_t>(size)) != 0 && ::ftruncate(fd_, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+
+        void* view = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (view == MAP_FAILED)
+        {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        view_ = static_cast<char*>(view);
+#endif // _WIN32
+
+        offset_ = 0;
+        segmentStart_ = now;
+
+        // ֻ maxSegments ֶ
+        if (config_.maxSegments > 0 && segmentIndex_ >= config_.maxSegments)
+        {
+            std::error_code ec;
+            std::filesystem::remove(SegmentPath(segmentIndex_ - config_.maxSegments), ec);
+        }
+        return true;
+    }
+
+    void MappedRotatingFileSink::CloseSegment()
+    {
+        if (!view_)
+            return;
+
+        // ӳļضϵʵдĳȣȥԤĿհײ
+#ifdef _WIN32
+        UnmapViewOfFile(view_);
+        CloseHandle(mapping_);
+
+        LARGE_INTEGER end{};
+        end.QuadPart = static_cast<LONGLONG>(offset_);
+        if (SetFilePointerEx(file_, end, nullptr, FILE_BEGIN))
+            SetEndOfFile(file_);
+        CloseHandle(file_);
+
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        ::munmap(view_, config_.segmentSize);
+        if (::ftruncate(fd_, static_cast<off_t>(offset_)) != 0)
+        {
+            // ضʧֻļβ¿հףӰѾд
+        }
+        ::close(fd_);
+        fd_ = -1;
+#endif // _WIN32
+
+        view_ = nullptr;
+        offset_ = 0;
+    }
+
+    void MappedRotatingFileSink::Flush()
+    {
+        if (!view_ || offset_ == 0)
+            return;
+
+        // ӳҳϵͳں̨дأֻ󾡿쿪ʼдȴ
+#ifdef _WIN32
+        FlushViewOfFile(view_, offset_);
+#else
+        ::msync(view_, offset_, MS_ASYNC);
+#endif // _WIN32
+    }
+} // namespace CBR::Engine::Debug
@@ -1,49 +1,27 @@
 #include "pch.h"
 #include "Engine/Debug/Logger.h"
+#include "Engine/Utility/Environment.h"
+#include "Engine/Memory/MemoryTag.h"
+#include "Engine/Debug/Profiler.h"
 
 namespace CBR::Engine::Debug
 {
     std::atomic<uint16_t> Logger::s_logSequence{ 0 };
 
-    struct ColorGuard {
-#ifdef _WIN32
-        HANDLE h{};
-        WORD   restore{};
-        ColorGuard(HANDLE hConsole, WORD color, WORD restoreAttr) : h(hConsole), restore(restoreAttr) {
-            if (h) SetConsoleTextAttribute(h, color);
-        }
-        ~ColorGuard() { if (h) SetConsoleTextAttribute(h, restore); }
-#else
-        std::string reset = "\x1b[0m";
-        ColorGuard(const char* colorSeq) { std::fputs(colorSeq, stdout); }
-        ~ColorGuard() { std::fputs(reset.c_str(), stdout); }
-#endif
-    };
-
     Logger::Logger()
     {
 #ifdef _DEBUG
-        // ̨
-        OpenDebugConsole();
+        // Debug ´ԼĿ̨
+        sinks_.push_back(std::make_unique<ConsoleLogSink>(true));
+#else
+        sinks_.push_back(std::make_unique<ConsoleLogSink>(false));
 #endif // _DEBUG
-
-#ifdef _WIN32
-        // ǫ̃
-        hConsole_ = GetStdHandle(STD_OUTPUT_HANDLE);
-
-        CONSOLE_SCREEN_BUFFER_INFO info{};
-        if (hConsole_ && GetConsoleScreenBufferInfo(hConsole_, &info)) {
-            defaultAttr_ = info.wAttributes;
-        }
-#endif // _WIN32
     }
 
     Logger::~Logger()
     {
-#ifdef _WIN32
-        // رտ̨
-        FreeConsole();
-#endif // _WIN32
+        StopAsync();
+        ClearSinks();
     }
 
 
@@ -69,125 +47,441 @@ namespace CBR::Engine::Debug
 
     void Logger::Write(const LogLevel& level, std::string_view message, std::string_view file, int line, std::string_view func)
     {
-        std::scoped_lock lock(mutex_);
+        CBR_PROFILE_SCOPE("Logger::Write");
+
+        // źʱڵ߳ȷ֤첽˳ʱȻǵʱ
+        LogRecord record;
+        record.level = level.value;
+        record.sequence = ++s_logSequence;
+        record.line = line;
+        record.timestamp = Utility::Clock::SystemNow();
+        record.file = file.data();
+        record.fileLength = static_cast<uint32_t>(file.size());
+        record.func = func.data();
+        record.funcLength = static_cast<uint32_t>(func.size());
+        record.truncated = message.size() > kLogRecordMessageSize;
+        record.messageLength = static_cast<uint32_t>(std::min<std::size_t>(message.size(), kLogRecordMessageSize));
+        std::memcpy(record.message, message.data(), record.messageLength);
+
+        Submit(record);
+    }
 
-#ifdef _WIN32
-        ColorGuard cg(hConsole_, level.ToColor(), defaultAttr_);
-#else
-        //  ANSI ӳ䣨ʾ⣩
-        const char* seq = "\x1b[37m";
-        switch (level.value) {
-        case LogLevel::Value::Info:  seq = "\x1b[92m"; break; // 
-        case LogLevel::Value::Warn:  seq = "\x1b[93m"; break; // 
-        case LogLevel::Value::Error: seq = "\x1b[91m"; break; // 
-        case LogLevel::Value::Debug: seq = "\x1b[96m"; break; // 
+    void Logger::Submit(const LogRecord& record)
+    {
+        CBR_PROFILE_SCOPE("Logger::Submit");
+
+        {
+            ProducerScope producer(producers_);
+            if (async_.load(std::memory_order_seq_cst))
+            {
+                Enqueue(record);
+                return;
+            }
         }
-        ColorGuard cg(seq);
-#endif // _WIN32
+        WriteRecord(record);
+    }
 
-        std::size_t windowWidth = kConsoleWindowWidth;
-#ifdef _WIN32
-        CONSOLE_SCREEN_BUFFER_INFO csbi{};
-        if (hConsole_ && GetConsoleScreenBufferInfo(hConsole_, &csbi)) {
-            windowWidth = static_cast<std::size_t>(csbi.srWindow.Right - csbi.srWindow.Left + 1);
+    void Logger::Enqueue(const LogRecord& record)
+    {
+        while (!queue_->TryPush(record))
+        {
+            switch (overflowPolicy_)
+            {
+            case LogOverflowPolicy::Block:
+                // д̺߳óʱƬڳռ
+                wakeSignal_.fetch_add(1, std::memory_order_release);
+                wakeSignal_.notify_one();
+                std::this_thread::yield();
+                break;
+            case LogOverflowPolicy::DropNewest:
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            case LogOverflowPolicy::DropOldest:
+            {
+                LogRecord oldest;
+                if (queue_->TryPop(oldest))
+                {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    processed_.fetch_add(1, std::memory_order_release);
+                }
+            } break;
+            }
         }
-        if (windowWidth == 0) windowWidth = kConsoleWindowWidth;
-#endif
 
-        // header: [#logSequence] [timestamp] [LEVEL] [location]
-        std::ostringstream headerOss;
-        
-        uint16_t seq = ++s_logSequence;
-        headerOss << "[#" << seq << "] ";
-        headerOss << '[' << GetTimestamp() << "] "
-            << '[' << level.ToString() << "] ";
-        if (level.value == LogLevel::Value::Info || level.value == LogLevel::Value::Warn) {
-            headerOss << ' ';
+        enqueued_.fetch_add(1, std::memory_order_release);
+        wakeSignal_.fetch_add(1, std::memory_order_release);
+        wakeSignal_.notify_one();
+    }
+
+    void Logger::StartAsync(const AsyncLogConfig& config)
+    {
+        if (async_.load(std::memory_order_acquire))
+            return;
+
+        Memory::MemoryTagScope memoryTag(Memory::MemoryTag::Logger);
+        queue_ = std::make_unique<LogRingBuffer<LogRecord>>(config.capacity);
+        overflowPolicy_ = config.overflowPolicy;
+        stopWriter_.store(false, std::memory_order_relaxed);
+        writerThread_ = std::thread(&Logger::WriterThreadMain, this);
+        async_.store(true, std::memory_order_release);
+    }
+
+    void Logger::StopAsync()
+    {
+        if (!async_.exchange(false, std::memory_order_seq_cst))
+            return;
+
+        // ֮LOGı·ѾӵĶƼ¼Ȼдļ
+        binary_.store(false, std::memory_order_seq_cst);
+
+        // Ѿͨ߿ܻ Enqueue Block Ҫд߳ڳռ䣩Ƕ뿪
+        while (producers_.load(std::memory_order_seq_cst) != 0)
+        {
+            std::this_thread::yield();
         }
 
-        // location
-        if (!file.empty()) {
-            std::size_t pos = file.find_last_of("/\\");
-            std::string_view fname = (pos == std::string_view::npos) ? file : file.substr(pos + 1);
-            headerOss << '[' << fname << ':' << line << " | " << func << ']';
+        stopWriter_.store(true, std::memory_order_release);
+        wakeSignal_.fetch_add(1, std::memory_order_release);
+        wakeSignal_.notify_one();
+        if (writerThread_.joinable())
+            writerThread_.join();
+
+        // лڼļ¼ɵǰ߳
+        LogRecord record;
+        while (queue_->TryPop(record))
+        {
+            WriteRecord(record);
+            processed_.fetch_add(1, std::memory_order_release);
         }
+        processed_.notify_all();
+        queue_.reset();
 
-        std::string header = headerOss.str();
+        std::scoped_lock lock(mutex_);
+        if (binaryFile_.is_open())
+            binaryFile_.close();
+    }
 
-        //  header header ڿȣҲڿУ
-        std::ostringstream out;
+    bool Logger::OpenBinaryLog(const std::filesystem::path& path)
+    {
+        // Ƽ¼д̣߳ͬģʽû
+        if (!async_.load(std::memory_order_acquire))
+            return false;
 
-        auto WriteWrapped = [&](std::string_view text, std::size_t indentSpaces)
-            {
-                const std::string indent(indentSpaces, ' ');
+        std::scoped_lock lock(mutex_);
+        if (binaryFile_.is_open())
+            binaryFile_.close();
+
+        binaryFile_.open(path, std::ios::binary | std::ios::trunc);
+        if (!binaryFile_)
+            return false;
+
+        LogBinary::FileHeader header{};
+        std::memcpy(header.magic, LogBinary::kMagic, sizeof(header.magic));
+        header.version = LogBinary::kVersion;
+        binaryFile_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        // һļùĵõidļЧһԪд
+        nextBinarySiteId_ = 1;
+        ++binaryEpoch_;
+        binary_.store(true, std::memory_order_release);
+        return true;
+    }
 
-                // һв
-                bool first = true;
+    void Logger::CloseBinaryLog()
+    {
+        if (!binary_.exchange(false, std::memory_order_acq_rel))
+            return;
 
-                while (!text.empty())
-                {
-                    if (!first) out << indent;
+        Flush();
 
-                    const std::size_t usableWidth =
-                        (windowWidth > indentSpaces) ? (windowWidth - indentSpaces) : 1;
+        std::scoped_lock lock(mutex_);
+        binaryFile_.close();
+    }
 
-                    const std::size_t len = std::min<std::size_t>(text.size(), usableWidth);
-                    out << text.substr(0, len) << '\n';
-                    text.remove_prefix(len);
+    void Logger::WriteBinaryRecord(const LogRecord& record)
+    {
+        if (!binaryFile_.is_open())
+            return;
 
-                    first = false;
-                }
+        auto put = [this](const auto& value)
+            {
+                binaryFile_.write(reinterpret_cast<const char*>(&value), sizeof(value));
             };
 
-        // headerУindent=0
-        if (!header.empty())
-            WriteWrapped(header, 0);
+        const int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(record.timestamp.time_since_epoch()).count();
+        if (!record.binary)
+        {
+            // Ѿʽõı¼ûеõ㣬λúıֱд chunk
+            const std::string_view file(record.file ? record.file : "", record.fileLength);
+            const std::string_view func(record.func ? record.func : "", record.funcLength);
+            const std::string_view ellipsis = record.truncated ? "..." : "";
+            put(LogBinary::ChunkType::Message);
+            put(static_cast<uint8_t>(record.level));
+            put(record.sequence);
+            put(timestamp);
+            put(static_cast<uint32_t>(record.line));
+            put(static_cast<uint16_t>(file.size()));
+            put(static_cast<uint16_t>(func.size()));
+            put(static_cast<uint16_t>(record.messageLength + ellipsis.size()));
+            binaryFile_.write(file.data(), file.size());
+            binaryFile_.write(func.data(), func.size());
+            binaryFile_.write(record.message, record.messageLength);
+            binaryFile_.write(ellipsis.data(), ellipsis.size());
+            return;
+        }
+
+        LogSite& site = *record.site;
+        if (site.binaryEpoch != binaryEpoch_)
+        {
+            // õһγڵǰļдõ㶨壬ļ¼ֻid
+            site.binaryEpoch = binaryEpoch_;
+            site.binaryId = nextBinarySiteId_++;
+
+            const std::string_view file = site.location.file_name();
+            const std::string_view func = ShortFunctionName(site.location.function_name());
+            const std::string_view format(record.format ? record.format : "", record.formatLength);
+            put(LogBinary::ChunkType::SiteDefinition);
+            put(site.binaryId);
+            put(static_cast<uint8_t>(site.level));
+            put(static_cast<uint32_t>(site.location.line()));
+            put(static_cast<uint16_t>(file.size()));
+            put(static_cast<uint16_t>(func.size()));
+            put(static_cast<uint16_t>(format.size()));
+            binaryFile_.write(file.data(), file.size());
+            binaryFile_.write(func.data(), func.size());
+            binaryFile_.write(format.data(), format.size());
+        }
+
+        put(LogBinary::ChunkType::Event);
+        put(site.binaryId);
+        put(record.sequence);
+        put(timestamp);
+        put(static_cast<uint16_t>(record.messageLength));
+        binaryFile_.write(record.message, record.messageLength);
+    }
+
+    void Logger::RegisterSuppressedSite(LogSite& site) noexcept
+    {
+        if (site.registered.exchange(true, std::memory_order_acq_rel))
+            return;
+
+        LogSite* head = suppressedSites_.load(std::memory_order_relaxed);
+        do
+        {
+            site.nextSuppressed = head;
+        } while (!suppressedSites_.compare_exchange_weak(head, &site, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void Logger::ReportSuppressed(LogSite& site)
+    {
+        const uint32_t repeats = site.repeats.exchange(0, std::memory_order_relaxed);
+        const uint32_t suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+        if (repeats == 0 && suppressed == 0)
+            return;
+
+        // õõԼλúͼʱԭϢһ
+        const std::string_view file = site.location.file_name();
+        const std::string_view func = ShortFunctionName(site.location.function_name());
+
+        LogRecord notice;
+        notice.level = site.level;
+        notice.sequence = ++s_logSequence;
+        notice.timestamp = Utility::Clock::SystemNow();
+        notice.line = static_cast<int>(site.location.line());
+        notice.file = file.data();
+        notice.fileLength = static_cast<uint32_t>(file.size());
+        notice.func = func.data();
+        notice.funcLength = static_cast<uint32_t>(func.size());
+
+        int result = 0;
+        if (repeats != 0 && suppressed != 0)
+            result = std::snprintf(notice.message, kLogRecordMessageSize, "(previous message repeated %u times, %u more suppressed by rate limit %u/s)", repeats, suppressed, site.suppression.maxPerSecond);
+        else if (repeats != 0)
+            result = std::snprintf(notice.message, kLogRecordMessageSize, "(previous message repeated %u times)", repeats);
         else
-            out << '\n';
+            result = std::snprintf(notice.message, kLogRecordMessageSize, "(%u messages suppressed by rate limit %u/s)", suppressed, site.suppression.maxPerSecond);
+        notice.messageLength = static_cast<uint32_t>(std::clamp(result, 0, static_cast<int>(kLogRecordMessageSize) - 1));
 
-        //  message
-        constexpr std::size_t kMessageIndent = 0; // ڶ
+        Submit(notice);
+    }
 
-        if (message.empty()) {
-            out << std::string(kMessageIndent, ' ') << '\n';
+    void Logger::Flush()
+    {
+        // ûظȲϣҲ Flush 
+        for (LogSite* site = suppressedSites_.load(std::memory_order_acquire); site; site = site->nextSuppressed)
+        {
+            ReportSuppressed(*site);
         }
-        else {
-            // message һпʼ kMessageIndent
-            // ζſÿ = windowWidth - kMessageIndent
-            WriteWrapped(message, kMessageIndent);
+
+        if (async_.load(std::memory_order_acquire))
+        {
+            const uint64_t target = enqueued_.load(std::memory_order_acquire);
+            wakeSignal_.fetch_add(1, std::memory_order_release);
+            wakeSignal_.notify_one();
+
+            uint64_t done = processed_.load(std::memory_order_acquire);
+            while (done < target && async_.load(std::memory_order_acquire))
+            {
+                processed_.wait(done, std::memory_order_acquire);
+                done = processed_.load(std::memory_order_acquire);
+            }
         }
 
-        std::string finalText = out.str();
-        finalText += '\n';
+        std::scoped_lock lock(mutex_);
+        for (const auto& sink : sinks_)
+        {
+            sink->Flush();
+        }
+    }
 
-#ifdef _WIN32
-        std::wstring wtext = AnsiToUtf16(finalText);
-        DWORD written = 0;
-        if (!WriteConsoleW(hConsole_, wtext.c_str(), (DWORD)wtext.size(), &written, nullptr))
+    void Logger::AddSink(std::unique_ptr<ILogSink> sink)
+    {
+        if (!sink)
+            return;
+
+        std::scoped_lock lock(mutex_);
+        sinks_.push_back(std::move(sink));
+    }
+
+    void Logger::ClearSinks()
+    {
+        std::scoped_lock lock(mutex_);
+        for (const auto& sink : sinks_)
         {
-            std::cout << finalText;
+            sink->Flush();
         }
+        sinks_.clear();
+    }
 
-        // ͬ
-        OutputDebugStringW(wtext.c_str());
-#else
-        std::cout << finalText;
-#endif // _WIN32
+    void Logger::ConfigureSinksFromEnvironment()
+    {
+        if (const std::string path = Utility::ReadEnvironmentVariable("CBR_LOG_FILE"); !path.empty())
+        {
+            if (auto sink = std::make_unique<FileLogSink>(path); sink->IsOpen())
+                AddSink(std::move(sink));
+        }
+
+        // CBR_LOG_MAPPED=<base>ѡ CBR_LOG_MAPPED_SEGMENT_MBĬ16 CBR_LOG_MAPPED_ROLL_SECONDSĬֻСл
+        if (const std::string base = Utility::ReadEnvironmentVariable("CBR_LOG_MAPPED"); !base.empty())
+        {
+            MappedLogConfig config;
+            config.basePath = base;
+            if (const std::string mb = Utility::ReadEnvironmentVariable("CBR_LOG_MAPPED_SEGMENT_MB"); !mb.empty())
+                config.segmentSize = static_cast<std::size_t>(std::max<int>(1, std::atoi(mb.c_str()))) * 1024 * 1024;
+            if (const std::string seconds = Utility::ReadEnvironmentVariable("CBR_LOG_MAPPED_ROLL_SECONDS"); !seconds.empty())
+                config.rollInterval = std::chrono::seconds(std::max<int>(0, std::atoi(seconds.c_str())));
+
+            if (auto sink = std::make_unique<MappedRotatingFileSink>(config); sink->IsOpen())
+                AddSink(std::move(sink));
+        }
+    }
+
+    void Logger::WriterThreadMain()
+    {
+        // д̸߳ʽдļʱķ䶼־ϵͳ
+        Memory::MemoryTagScope memoryTag(Memory::MemoryTag::Logger);
+        LogRecord record;
+        for (;;)
+        {
+            const uint32_t signal = wakeSignal_.load(std::memory_order_acquire);
+
+            bool any = false;
+            while (queue_->TryPop(record))
+            {
+                WriteRecord(record);
+                processed_.fetch_add(1, std::memory_order_release);
+                any = true;
+            }
+            if (any)
+            {
+                if (binary_.load(std::memory_order_relaxed))
+                {
+                    std::scoped_lock lock(mutex_);
+                    binaryFile_.flush();
+                }
+                processed_.notify_all();
+            }
+
+            if (const uint64_t dropped = dropped_.load(std::memory_order_relaxed); dropped != reportedDropped_)
+            {
+                LogRecord notice;
+                notice.level = LogLevel::Value::Warn;
+                notice.sequence = ++s_logSequence;
+                notice.timestamp = Utility::Clock::SystemNow();
+                const auto result = std::snprintf(notice.message, kLogRecordMessageSize,
+                    "[logger] %llu messages dropped (queue overflow)", static_cast<unsigned long long>(dropped - reportedDropped_));
+                notice.messageLength = static_cast<uint32_t>(std::clamp(result, 0, static_cast<int>(kLogRecordMessageSize) - 1));
+                WriteRecord(notice);
+                reportedDropped_ = dropped;
+            }
+
+            if (stopWriter_.load(std::memory_order_acquire))
+                break;
+
+            // û¼¼ߣֱߵ wakeSignal_
+            wakeSignal_.wait(signal, std::memory_order_acquire);
+        }
+    }
+
+    void Logger::WriteRecord(const LogRecord& record)
+    {
+        std::scoped_lock lock(mutex_);
+
+        if (record.binary)
+        {
+            WriteBinaryRecord(record);
+            return;
+        }
+
+        const LogLevel level(record.level);
+        const std::string_view file(record.file ? record.file : "", record.fileLength);
+        const std::string_view func(record.func ? record.func : "", record.funcLength);
+        // ֱü¼Ļضϱ sink 
+        const std::string_view message(record.message, record.messageLength);
+
+        // header: [#logSequence] [timestamp] [LEVEL] [location]ʱһջϸʽڴ
+        char timestamp[16];
+        const std::size_t timestampLength = FormatTimestamp(record.timestamp, timestamp, sizeof(timestamp));
+
+        char header[kLogHeaderSize];
+        const std::string_view padding = (level.value == LogLevel::Value::Info || level.value == LogLevel::Value::Warn) ? " " : "";
+        auto result = std::format_to_n(header, static_cast<std::ptrdiff_t>(sizeof(header)), "[#{}] [{}] [{}] {}",
+            record.sequence, std::string_view(timestamp, timestampLength), level.ToString(), padding);
+
+        // location
+        if (!file.empty()) {
+            std::size_t pos = file.find_last_of("/\\");
+            std::string_view fname = (pos == std::string_view::npos) ? file : file.substr(pos + 1);
+            const std::ptrdiff_t room = (header + sizeof(header)) - result.out;
+            result = std::format_to_n(result.out, room, "[{}:{} | {}]", fname, record.line, func);
+        }
+
+        const std::string_view headerText(header, static_cast<std::size_t>(result.out - header));
+
+        for (const auto& sink : sinks_)
+        {
+            sink->Write(record, headerText, message);
+        }
+
+        // ģʽı¼ͬдļ־ûжظ/ʾ
+        WriteBinaryRecord(record);
     }
 
-    std::string Logger::GetTimestamp() const
+    std::size_t Logger::FormatTimestamp(std::chrono::system_clock::time_point now, char* buffer, std::size_t size)
     {
         using namespace std::chrono;
-        const auto now = system_clock::now();
         const std::time_t t = system_clock::to_time_t(now);
         std::tm tm{};
+#ifdef _WIN32
         localtime_s(&tm, &t);
+#else
+        localtime_r(&t, &tm);
+#endif
         const auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
 
-        std::ostringstream oss;
-        oss << std::put_time(&tm, "%H:%M:%S")
-            << '.' << std::setw(3) << std::setfill('0') << ms.count();
-        return oss.str();
+        const auto result = std::format_to_n(buffer, static_cast<std::ptrdiff_t>(size), "{:02}:{:02}:{:02}.{:03}",
+            tm.tm_hour, tm.tm_min, tm.tm_sec, ms.count());
+        return static_cast<std::size_t>(result.out - buffer);
     }
 
     std::string Logger::ExtractFilename(std::string_view filepath) const
@@ -196,19 +490,6 @@ namespace CBR::Engine::Debug
         return (pos == std::string_view::npos) ? std::string(filepath) : std::string(filepath.substr(pos + 1));
     }
 
-    std::wstring Logger::AnsiToUtf16(std::string_view s)
-    {
-        if (s.empty()) return {};
-        constexpr UINT kCodePage = CP_ACP;
-
-        int wlen = MultiByteToWideChar(kCodePage, 0, s.data(), (int)s.size(), nullptr, 0);
-        if (wlen <= 0) return {};
-
-        std::wstring w(wlen, L'\0');
-        MultiByteToWideChar(kCodePage, 0, s.data(), (int)s.size(), w.data(), wlen);
-        return w;
-    }
-
     std::string_view Logger::ShortFunctionName(std::string_view sig)
     {
         // ҵб
@@ -232,71 +513,4 @@ namespace CBR::Engine::Debug
             prefix.size() + params.size()
         };
     }
-
-    void Logger::OpenDebugConsole()
-    {
-        // ̨븴ø̨̿ AttachConsole(ATTACH_PARENT_PROCESS)
-        AllocConsole();
-        SetConsoleOutputCP(CP_UTF8);
-        SetConsoleCP(CP_UTF8);
-
-        //  C/CPP ׼ָ̨
-        FILE* fp;
-        freopen_s(&fp, "CONOUT$", "w", stdout);
-        freopen_s(&fp, "CONOUT$", "w", stderr);
-        freopen_s(&fp, "CONIN$", "r", stdin);
-
-        // UTF-8 
-        SetConsoleOutputCP(CP_UTF8);
-
-#ifdef _WIN32
-        // ȡ׼
-        HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-
-        // ûС
-        COORD bufferSize;
-        bufferSize.X = 400;
-        bufferSize.Y = 2000;
-        SetConsoleScreenBufferSize(hOut, bufferSize);
-
-        // ôڿɼĴС벻 bufferSize
-        SMALL_RECT windowRect;
-        windowRect.Left = 0;
-        windowRect.Top = 0;
-        windowRect.Right = kConsoleWindowWidth - 1;          //  = Right - Left + 1
-        windowRect.Bottom = kConsoleWindowHeight - 1; // ɼԼϲод-1
-        SetConsoleWindowInfo(hOut, TRUE, &windowRect);
-
-        // áβԶС
-        DWORD mode = 0;
-        if (GetConsoleMode(hOut, &mode))
-        {
-            mode &= ~ENABLE_WRAP_AT_EOL_OUTPUT;  //  wrap
-            SetConsoleMode(hOut, mode);
-        }
-
-        // øı䴰ڴС
-        HWND hwndConsole = GetConsoleWindow();
-        if (hwndConsole)
-        {
-            // ȥɵС߿(ק)󻯰ť
-            LONG style = GetWindowLong(hwndConsole, GWL_STYLE);
-            style &= ~WS_THICKFRAME;   // ֹק߿С
-            style &= ~WS_MAXIMIZEBOX;  // ֹ
-            SetWindowLong(hwndConsole, GWL_STYLE, style);
-
-            // ҵϵͳ˵ Size/Maximize
-            HMENU hMenu = GetSystemMenu(hwndConsole, FALSE);
-            if (hMenu)
-            {
-                EnableMenuItem(hMenu, SC_SIZE, MF_BYCOMMAND | MF_GRAYED);
-                EnableMenuItem(hMenu, SC_MAXIMIZE, MF_BYCOMMAND | MF_GRAYED);
-            }
-
-            // ʽЧ
-            SetWindowPos(hwndConsole, nullptr, 0, 0, 0, 0,
-                SWP_NOMOVE | SWP_NOSIZE | SWP_NOZORDER | SWP_FRAMECHANGED);
-        }
-#endif // _WIN32
-    }
 } // namespace CBR::Engine::Debug
\ No newline at end of file
@@ -27,7 +27,13 @@
 //--------------------------------------------------------------------------------
 #include "pch.h"
 #include "Engine/Debug/MemoryLT.h"
+#include "Engine/Debug/MemoryLTSites.h"
+#include "Engine/Debug/MemoryStats.h"
+#include "Engine/Debug/MemorySampler.h"
+#include "Engine/Memory/EngineHeap.h"
+#include "Engine/Memory/NoAllocTracking.h"
 #include "Engine/Debug/Logger.h"
+#include "Engine/Debug/Profiler.h"
 
 #if defined(_DEBUG) || defined(DEBUG)
 
@@ -36,6 +42,11 @@
 #include <sal.h>
 #endif
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define CBR_MLT_SSE2 1
+#endif
+
 /// Override (only for this file) the _HAS_EXCEPTIONS values. Otherwise a compile error is 
 /// generated (aka: error C3861: '__uncaught_exception': identifier not found)
 #ifdef _HAS_EXCEPTIONS
@@ -58,7 +69,8 @@ namespace CBR::Engine::Debug::mlt
     /** Free memory for usual usage*/
 	void Free(void* mem);
 
-    struct MemoryAllocationRecord
+    // 뵽 max_align_t֤ںûڴ malloc صһ
+    struct alignas(alignof(std::max_align_t)) MemoryAllocationRecord
     {
         /**address returned to the caller after allocation*/
         void* address_;
@@ -72,12 +84,37 @@ namespace CBR::Engine::Debug::mlt
         /**source line of the allocation request*/
         unsigned int line_;
 
+        /**shard that owns this record (may differ from the freeing thread's shard)*/
+        unsigned int shard_;
+
+        /**kRecord* bits, accessed through std::atomic_ref*/
+        unsigned int flags_;
+
+        /**Memory::MemoryTag that was active on the allocating thread*/
+        Memory::MemoryTag tag_;
+
+        /**interned allocation site (file/line and optional call stack)*/
+        AllocationSite* site_;
+
         /**linked list next node*/
         MemoryAllocationRecord* next_;
         /**linked list prev node*/
         MemoryAllocationRecord* prev_;
     };
 
+    /** Number of registries; must be a power of two */
+    constexpr unsigned int kLeakTrackerShardCount = 16;
+
+    /** The guard bands of this block were already reported as corrupted */
+    constexpr unsigned int kRecordCorruptionReported = 1u << 0;
+    /** The block ends right before an inaccessible page (AllocateGuardedPages) */
+    constexpr unsigned int kRecordPageGuarded = 1u << 1;
+    /** The block was freed and is waiting in a quarantine FIFO */
+    constexpr unsigned int kRecordQuarantined = 1u << 2;
+
+    /** Freed payloads are filled with this byte while quarantined (same as the MSVC debug heap) */
+    constexpr unsigned char kPoisonByte = 0xDD;
+
 	class LeakTracker
 	{
 	public:
@@ -89,48 +126,310 @@ namespace CBR::Engine::Debug::mlt
 		/** Prints all heap and reference leaks to stderr. */
 		static void PrintMemoryLeaks();
         static void CheckHeapCorruption();
+        static void CollectHeapStats(HeapStats& stats, uint64_t& bytesAllocated);
 
         void CheckHeapCorruptionAtAddress(void* address);
+        std::size_t CheckHeapCorruptionIncremental(std::chrono::steady_clock::time_point deadline);
+        void DrainQuarantine();
 
 	private:
-		MemoryAllocationRecord* memoryAllocations_;
-		int memoryAllocationCount_;
-		std::recursive_mutex mutex_;
-		std::size_t maxSize_;
-		std::size_t maxLine_;
+        // ÿ̶̹߳һƬǼǷ䣬̵ͬ߳ new/delete ڲͬϡ
+        // ֻ PrintMemoryLeaks / CheckHeapCorruption αзƬ
+        // ͳƼڷƬڸ£һ relaxed ԭ
+        struct alignas(64) Shard
+        {
+            std::mutex mutex;
+            MemoryAllocationRecord* allocations = nullptr;
+            int count = 0;
+
+            // λáFree ժαڵĿʱαƵһ
+            MemoryAllocationRecord* scanCursor = nullptr;
+            bool scanning = false;
+
+            // ͷźĿ飬Ƚȳü¼ next_ 
+            MemoryAllocationRecord* quarantineHead = nullptr;
+            MemoryAllocationRecord* quarantineTail = nullptr;
+            std::size_t quarantineBytes = 0;
+
+            std::atomic<uint64_t> allocationCount{ 0 };
+            std::atomic<uint64_t> freeCount{ 0 };
+            std::atomic<uint64_t> bytesAllocated{ 0 };
+            std::atomic<uint64_t> liveBlocks[kSizeClassCount] = {};
+            std::atomic<uint64_t> classAllocations[kSizeClassCount] = {};
+        };
+
+        // ڱдĿ顣ƬʱзƬ־ȷſ֮־Ҳڴ棩
+        struct CorruptionReport
+        {
+            const void* address;
+            std::size_t size;
+            const char* file;
+            unsigned int line;
+            std::size_t before; // һдֽڿ֮ǰԶkNoCorruption ʾûбд
+            std::size_t after;  // һдֽڿĩβ֮ƫ
+        };
+        static constexpr std::size_t kNoCorruption = static_cast<std::size_t>(-1);
+        static constexpr std::size_t kMaxReportsPerSlice = 16;
+
+        // ֻڵһηʱ trueͬһ鲻ظ
+        static bool FindCorruption(MemoryAllocationRecord* rec, CorruptionReport& report) noexcept;
+        static void ReportCorruption(const CorruptionReport& report);
+
+        void Quarantine(MemoryAllocationRecord* rec);
+        // ڼûд루ݱı䣩Ȼͷšrecords  next_ 
+        void ReleaseQuarantined(MemoryAllocationRecord* records);
+        static void ReleaseBlock(MemoryAllocationRecord* rec) noexcept;
+
+        static unsigned int CurrentShard() noexcept;
+        static void UpdateMax(std::atomic<std::size_t>& target, std::size_t value) noexcept;
+        static void AddRelaxed(std::atomic<uint64_t>& counter, uint64_t value) noexcept;
+
+		Shard shards_[kLeakTrackerShardCount];
+		std::atomic<std::size_t> maxSize_;
+		std::atomic<std::size_t> maxLine_;
+
+        // зƬãֵҪͬһϱȽ
+        alignas(64) std::atomic<std::size_t> currentBytes_;
+        std::atomic<std::size_t> peakBytes_;
+
+        unsigned int scanShard_; // ֻڳ ScanMutex_ ʱ
 	};
 
     static std::mutex InitMutex_;
     static bool HeapCorruptionEnabled_ = false;
     static int HeapCorruptionBuferSize_ = 2048;
+    static bool CaptureStacks_ = false;
+    static uint16_t StackDepth_ = 0;
+    static bool TrackPlainNew_ = false;
+    static const char* ReportPath_ = nullptr;
+    static std::chrono::microseconds CheckBudget_{ 0 };
+    static std::size_t PageGuardMinSize_ = 0;
+    static std::size_t PageGuardMaxSize_ = 0;
+    static char PageGuardFile_[128] = {};
+    static std::size_t PageSize_ = 4096;
+    static std::size_t QuarantineBytes_ = 0;
+    static unsigned int ShardMask_ = kLeakTrackerShardCount - 1;   // ʵʹõķƬһ
 	static AllocFuncPtr AllocFuncPtr_ = nullptr;
 	static FreeFuncPtr  FreeFuncPtr_ = nullptr;
 
     /** We reserve some memory to hold the mem for s_leakTracker */
-    static char MemleakTracker_[sizeof(LeakTracker)] = { 0 };
+    alignas(LeakTracker) static char MemleakTracker_[sizeof(LeakTracker)] = { 0 };
 
     /** Is the static pointer for leakTracker */
     static LeakTracker* LeakTracker_ = nullptr;
 
+    /** Frame counters, only touched by EndFrame / GetHeapStats (not on the allocation path) */
+    static std::mutex FrameStatsMutex_;
+    static FrameAllocationStats FrameTotals_;    // һ EndFrame ʱۼֵ
+    static FrameAllocationStats LastFrame_;
+
+    /** Incremental corruption check: one scanner at a time (EndFrame or the checker thread) */
+    static std::mutex ScanMutex_;
+    static std::thread CheckerThread_;
+    static std::mutex CheckerMutex_;
+    static std::condition_variable CheckerWake_;
+    static bool CheckerStop_ = false;
+    constexpr std::chrono::milliseconds kCheckerInterval{ 16 };
+
+    namespace
+    {
+        /** Returns the offset of the first byte that differs from expected, or size when the whole range matches. */
+        std::size_t FindByteMismatch(const unsigned char* data, std::size_t size, unsigned char expected) noexcept
+        {
+            std::size_t offset = 0;
+#ifdef CBR_MLT_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i pattern = _mm_set1_epi8(static_cast<char>(expected));
+            // һαȽ 64 ֽڣֵϲȫͬʱֻҪһ movemask
+            for (; offset + 64 <= size; offset += 64)
+            {
+                const __m128i* chunk = reinterpret_cast<const __m128i*>(data + offset);
+                const __m128i diff = _mm_or_si128(
+                    _mm_or_si128(_mm_xor_si128(_mm_loadu_si128(chunk), pattern), _mm_xor_si128(_mm_loadu_si128(chunk + 1), pattern)),
+                    _mm_or_si128(_mm_xor_si128(_mm_loadu_si128(chunk + 2), pattern), _mm_xor_si128(_mm_loadu_si128(chunk + 3), pattern)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(diff, zero)) != 0xFFFF)
+                    break;
+            }
+            for (; offset + 16 <= size; offset += 16)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+                const unsigned int equal = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, pattern)));
+                if (equal != 0xFFFF)
+                    return offset + std::countr_one(equal);
+            }
+#else
+            const uint64_t pattern = 0x0101010101010101ull * expected;
+            for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t))
+            {
+                uint64_t word;
+                std::memcpy(&word, data + offset, sizeof(word));
+                if (word != pattern)
+                    break;
+            }
+#endif
+            for (; offset < size; ++offset)
+            {
+                if (data[offset] != expected)
+                    return offset;
+            }
+            return size;
+        }
+
+        constexpr std::size_t AlignUp(std::size_t value, std::size_t alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        bool UsePageGuard(std::size_t size, const char* file) noexcept
+        {
+            if (size < PageGuardMinSize_ || size > PageGuardMaxSize_)
+                return false;
+            return PageGuardFile_[0] == '\0' || std::strstr(file, PageGuardFile_) != nullptr;
+        }
+
+        // ҳĲ֣[¼ͷ | ûڴ][ɷʵҳ]ûڴ水 max_align_t ҳ
+        // µļֽڱΪ 0ͷʱ
+        struct GuardedLayout
+        {
+            std::size_t payloadSpan; // ûڴ㵽ҳľ
+            std::size_t dataBytes;   // ҳ֮ǰĿɷʲ
+        };
+
+        GuardedLayout GetGuardedLayout(std::size_t size) noexcept
+        {
+            const std::size_t payloadSpan = AlignUp(size, alignof(MemoryAllocationRecord));
+            return GuardedLayout{ payloadSpan, AlignUp(payloadSpan + sizeof(MemoryAllocationRecord), PageSize_) };
+        }
+
+        /** Maps pages for one block followed by an inaccessible page. Returns the payload address, or nullptr on failure. */
+        unsigned char* AllocateGuardedPages(std::size_t size) noexcept
+        {
+            const GuardedLayout layout = GetGuardedLayout(size);
+            const std::size_t total = layout.dataBytes + PageSize_;
+#ifdef _WIN32
+            unsigned char* base = static_cast<unsigned char*>(VirtualAlloc(nullptr, total, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+            if (!base)
+                return nullptr;
+
+            DWORD oldProtect = 0;
+            if (!VirtualProtect(base + layout.dataBytes, PageSize_, PAGE_NOACCESS, &oldProtect))
+            {
+                VirtualFree(base, 0, MEM_RELEASE);
+                return nullptr;
+            }
+#else
+            void* mapped = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED)
+                return nullptr;
+
+            unsigned char* base = static_cast<unsigned char*>(mapped);
+            if (::mprotect(base + layout.dataBytes, PageSize_, PROT_NONE) != 0)
+            {
+                ::munmap(base, total);
+                return nullptr;
+            }
+#endif
+            return base + layout.dataBytes - layout.payloadSpan;
+        }
+
+        void ReleaseGuardedPages(void* payload, std::size_t size) noexcept
+        {
+            const GuardedLayout layout = GetGuardedLayout(size);
+            unsigned char* base = static_cast<unsigned char*>(payload) + layout.payloadSpan - layout.dataBytes;
+#ifdef _WIN32
+            VirtualFree(base, 0, MEM_RELEASE);
+#else
+            ::munmap(base, layout.dataBytes + PageSize_);
+#endif
+        }
+
+        void StopCorruptionChecker()
+        {
+            if (!CheckerThread_.joinable())
+                return;
+
+            {
+                std::lock_guard<std::mutex> lk(CheckerMutex_);
+                CheckerStop_ = true;
+            }
+            CheckerWake_.notify_all();
+            CheckerThread_.join();
+        }
+
+        void CorruptionCheckerMain()
+        {
+            // ̨̲߳ռ֡ʱ䣬ҲԤֶΣⳤʱռŷƬ
+            const std::chrono::microseconds budget = std::max<std::chrono::microseconds>(CheckBudget_, std::chrono::milliseconds(1));
+            std::unique_lock<std::mutex> lk(CheckerMutex_);
+            while (!CheckerStop_)
+            {
+                lk.unlock();
+                CheckHeapCorruptionIncremental(budget);
+                lk.lock();
+                CheckerWake_.wait_for(lk, kCheckerInterval, [] { return CheckerStop_; });
+            }
+        }
+    }
+
 
     void Init(bool heapCorruptionCheck, int buffer)
+    {
+        Config config;
+        config.heapCorruptionCheck = heapCorruptionCheck;
+        config.buffer = buffer;
+        Init(config);
+    }
+
+    void Init(const Config& config)
     {
         std::lock_guard<std::mutex> lk(InitMutex_);
-        HeapCorruptionEnabled_ = heapCorruptionCheck;
-        HeapCorruptionBuferSize_ = buffer;
+        InitAllocationSites();
+        HeapCorruptionEnabled_ = config.heapCorruptionCheck;
+        HeapCorruptionBuferSize_ = config.buffer;
+        CaptureStacks_ = config.captureStacks;
+        StackDepth_ = static_cast<uint16_t>(std::clamp<int>(config.stackDepth, 1, static_cast<int>(kMaxStackDepth)));
+        TrackPlainNew_ = config.trackPlainNew;
+        ReportPath_ = config.reportPath;
+        CheckBudget_ = std::chrono::microseconds(std::max<int>(config.corruptionCheckBudgetUs, 0));
+        QuarantineBytes_ = config.quarantineBytes;
+        ShardMask_ = std::bit_floor(std::clamp<unsigned int>(config.registryShards, 1, kLeakTrackerShardCount)) - 1;
+        PageGuardMinSize_ = config.pageGuardMinSize;
+        PageGuardMaxSize_ = config.pageGuardMaxSize;
+        PageGuardFile_[0] = '\0';
+        if (config.pageGuardFile)
+            std::snprintf(PageGuardFile_, sizeof(PageGuardFile_), "%s", config.pageGuardFile);
+#ifdef _WIN32
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        PageSize_ = systemInfo.dwPageSize;
+#else
+        PageSize_ = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif
         LeakTracker_ = new(MemleakTracker_) LeakTracker;
         AllocFuncPtr_ = Alloc;
 		FreeFuncPtr_ = Free;
+
+        if (HeapCorruptionEnabled_ && config.corruptionCheckThread && !CheckerThread_.joinable())
+        {
+            CheckerStop_ = false;
+            CheckerThread_ = std::thread(CorruptionCheckerMain);
+        }
     }
 
     void Close()
     {
         std::lock_guard<std::mutex> lk(InitMutex_);
+        StopCorruptionChecker();
         if (LeakTracker_)
         {
+            // ֮ delete ֱͷţѾĿһͷ
+            QuarantineBytes_ = 0;
+            LeakTracker_->DrainQuarantine();
+            if (ReportPath_)
+                WriteAllocationReport(ReportPath_);
             LeakTracker_->PrintMemoryLeaks();
+            // ֹֻͣǼµķ䡣ڼĿż¼ͷ֮ delete ȻҪ Free ԭĵַ
             AllocFuncPtr_ = nullptr;
-            FreeFuncPtr_ = nullptr;
             LeakTracker_ = nullptr;
         }
     }
@@ -143,6 +442,19 @@ namespace CBR::Engine::Debug::mlt
         LeakTracker_->CheckHeapCorruption();
     }
 
+    std::size_t CheckHeapCorruptionIncremental(std::chrono::microseconds budget)
+    {
+        if (!HeapCorruptionEnabled_ || !LeakTracker_)
+            return 0;
+
+        // һ߳ڼʱֱӷأ֡ȴ
+        std::unique_lock<std::mutex> lk(ScanMutex_, std::try_to_lock);
+        if (!lk.owns_lock())
+            return 0;
+
+        return LeakTracker_->CheckHeapCorruptionIncremental(std::chrono::steady_clock::now() + budget);
+    }
+
     void* Alloc(std::size_t size, const char* file, unsigned int line)
     {
         return LeakTracker_->Alloc(size, file, line);
@@ -150,8 +462,8 @@ namespace CBR::Engine::Debug::mlt
 
     void LeakTrackerExit()
     {
+        StopCorruptionChecker();
         AllocFuncPtr_ = nullptr;
-        FreeFuncPtr_ = nullptr;
 
 		if (LeakTracker_)
 		{
@@ -162,15 +474,17 @@ namespace CBR::Engine::Debug::mlt
 
     void Free(void* mem)
     {
-        LeakTracker_->Free(mem);
+        // Close ֮ LeakTracker_ Ϊգ tracker һֱ MemleakTracker_ 
+        std::launder(reinterpret_cast<LeakTracker*>(MemleakTracker_))->Free(mem);
     }
 
 
     LeakTracker::LeakTracker() 
-        : memoryAllocations_(0)
-        , memoryAllocationCount_(0)
-        , maxSize_(0)
+        : maxSize_(0)
         , maxLine_(0)
+        , currentBytes_(0)
+        , peakBytes_(0)
+        , scanShard_(0)
     {
         atexit(LeakTrackerExit);
 
@@ -181,22 +495,65 @@ namespace CBR::Engine::Debug::mlt
     {
     }
 
+    unsigned int LeakTracker::CurrentShard() noexcept
+    {
+        // ̵߳һηʱ˳ƬȰ߳idϣֲ
+        static std::atomic<unsigned int> nextShard{ 0 };
+        thread_local const unsigned int shard = nextShard.fetch_add(1, std::memory_order_relaxed) & (kLeakTrackerShardCount - 1);
+        return shard & ShardMask_;
+    }
+
+    void LeakTracker::UpdateMax(std::atomic<std::size_t>& target, std::size_t value) noexcept
+    {
+        std::size_t current = target.load(std::memory_order_relaxed);
+        while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    void LeakTracker::AddRelaxed(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+    {
+        // ֻڳзƬʱãҪԭӵĶ--д
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
     void* Debug::mlt::LeakTracker::Alloc(std::size_t size, const char* file, unsigned int line)
     {
+        CBR_PROFILE_SCOPE("LeakTracker::Alloc");
+
         // nothrow new ʽõġǸ١·¼ֱӷ
         if (file == nullptr) {
-            return std::malloc(size);
+            if (!TrackPlainNew_) {
+                void* p = Memory::EngineAlloc(size);
+                if (!p) {
+                    throw std::bad_alloc();
+                }
+                return p;
+            }
+            file = ""; // ͨ operator newûļֻܿջ
         }
 
+        // ץջ LeakTracker::Alloc / mlt::Alloc / operator new
+        void* frames[kMaxStackDepth];
+        const uint16_t depth = CaptureStacks_ ? CaptureStack(frames, StackDepth_, 3) : 0;
+        AllocationSite* site = InternAllocationSite(file, line, frames, depth);
+
         unsigned char* mem = nullptr;
         MemoryAllocationRecord* rec = nullptr;
         void* payloadAddr = nullptr;
+        unsigned int flags = 0;
 
-        if (HeapCorruptionEnabled_) {
+        if (PageGuardMaxSize_ != 0 && UsePageGuard(size, file) && (mem = AllocateGuardedPages(size)) != nullptr) {
+            // Խдֱڱҳϴ쳣ӳʧܣӳޣʱ˻صͨ·
+            rec = reinterpret_cast<MemoryAllocationRecord*>(mem - sizeof(MemoryAllocationRecord));
+            payloadAddr = mem;
+            flags = kRecordPageGuarded;
+        }
+        else if (HeapCorruptionEnabled_) {
             // ڱ
             const std::size_t total =
                 sizeof(MemoryAllocationRecord) + size + HeapCorruptionBuferSize_ * 2;
-            mem = static_cast<unsigned char*>(std::calloc(total, 1));
+            mem = static_cast<unsigned char*>(Memory::EngineAllocZeroed(total));
             if (!mem) {
                 // throwing new 壺 bad_alloc ӳ OOM
                 throw std::bad_alloc();
@@ -207,7 +564,7 @@ namespace CBR::Engine::Debug::mlt
         else {
             // ͨ·
             const std::size_t total = sizeof(MemoryAllocationRecord) + size;
-            mem = static_cast<unsigned char*>(std::malloc(total));
+            mem = static_cast<unsigned char*>(Memory::EngineAlloc(total));
             if (!mem) {
                 throw std::bad_alloc();
             }
@@ -216,21 +573,36 @@ namespace CBR::Engine::Debug::mlt
         }
 
         //  ￪ʼ rec һǿ 
-        {
-            std::lock_guard<std::recursive_mutex> lk(mutex_);
-            rec->address_ = payloadAddr;
-            rec->size_ = size;      //   size_tҪǿת unsigned int
-            rec->file_ = file;
-            rec->line_ = line;
-            rec->next_ = memoryAllocations_;
-            rec->prev_ = nullptr;
-
-            if (maxSize_ < size) maxSize_ = size;
-            if (maxLine_ < line) maxLine_ = line;
+        const unsigned int shardIndex = CurrentShard();
+        rec->address_ = payloadAddr;
+        rec->size_ = size;      //   size_tҪǿת unsigned int
+        rec->file_ = file;
+        rec->line_ = line;
+        rec->shard_ = shardIndex;
+        rec->flags_ = flags;
+        rec->tag_ = Memory::GetCurrentMemoryTag();
+        rec->site_ = site;
+        rec->prev_ = nullptr;
+        OnSiteAlloc(site, size);
+
+        // Free ĺϷԼҪȿֵ֮ǰ
+        UpdateMax(maxSize_, size);
+        UpdateMax(maxLine_, line);
+        UpdateMax(peakBytes_, currentBytes_.fetch_add(size, std::memory_order_relaxed) + size);
 
-            if (memoryAllocations_) memoryAllocations_->prev_ = rec;
-            memoryAllocations_ = rec;
-            ++memoryAllocationCount_;
+        {
+            const std::size_t sizeClass = SizeClassOf(size);
+            Shard& shard = shards_[shardIndex];
+            std::lock_guard<std::mutex> lk(shard.mutex);
+            rec->next_ = shard.allocations;
+            if (shard.allocations) shard.allocations->prev_ = rec;
+            shard.allocations = rec;
+            ++shard.count;
+
+            AddRelaxed(shard.allocationCount, 1);
+            AddRelaxed(shard.bytesAllocated, size);
+            AddRelaxed(shard.liveBlocks[sizeClass], 1);
+            AddRelaxed(shard.classAllocations[sizeClass], 1);
         }
 
         return payloadAddr;
@@ -242,34 +614,26 @@ namespace CBR::Engine::Debug::mlt
         if (payloadAddr == 0)
             return;
 
-        unsigned char* mem = nullptr;
-        MemoryAllocationRecord* rec = nullptr;
-
-        if (HeapCorruptionEnabled_)
-        {
-            /// Backup passed in pointer to access memory allocation record
-            mem = ((unsigned char*)payloadAddr) - sizeof(MemoryAllocationRecord) - HeapCorruptionBuferSize_;
-
-            rec = (MemoryAllocationRecord*)(((unsigned char*)payloadAddr) - sizeof(MemoryAllocationRecord));
-        }
-        else
-        {
-            /// Backup passed in pointer to access memory allocation record
-            mem = ((unsigned char*)payloadAddr) - sizeof(MemoryAllocationRecord);
-
-            rec = (MemoryAllocationRecord*)mem;
-        }
+        /// Backup passed in pointer to access memory allocation record (it sits right before the payload in every mode)
+        MemoryAllocationRecord* rec = (MemoryAllocationRecord*)(((unsigned char*)payloadAddr) - sizeof(MemoryAllocationRecord));
 
         /// Sanity check: ensure that address in record matches passed in address
         if (rec->address_ != payloadAddr)
         {
             // This case could be a memory corruption, but most of the cases are memory allocations that was not tracked (because file was null).
-            free(payloadAddr);
+            Memory::EngineFree(payloadAddr);
+            return;
+        }
+
+        /// Sanity check: a quarantined block is still owned by the tracker
+        if (std::atomic_ref<unsigned int>(rec->flags_).load(std::memory_order_relaxed) & kRecordQuarantined)
+        {
+            CBR_LOG(Memory, Warn, "[memory] DOUBLE FREE: address {}, size {}, {}:{}.", payloadAddr, rec->size_, (rec->file_ && *rec->file_) ? rec->file_ : "<operator new>", rec->line_);
             return;
         }
 
         /// Sanity check: ensure that size is smaller than maximum (tracked)
-        if (rec->size_ > maxSize_)
+        if (rec->size_ > maxSize_.load(std::memory_order_relaxed))
         {
             std::cout << ("[memory] CORRUPTION: Attempting to free memory address with invalid memory allocation record (wrong size).\n");
             //std::cout << "S";
@@ -277,89 +641,384 @@ namespace CBR::Engine::Debug::mlt
         }
 
         /// Sanity check: ensure that line is smaller than maximum (tracked)
-        if (rec->line_ > maxLine_)
+        if (rec->line_ > maxLine_.load(std::memory_order_relaxed))
         {
             std::cout << ("[memory] CORRUPTION: Attempting to free memory address with invalid memory allocation record (wrong line).\n");
             //std::cout << "L";
             return;
         }
 
-        if (HeapCorruptionEnabled_)
+        const bool pageGuarded = (rec->flags_ & kRecordPageGuarded) != 0;
+        if (HeapCorruptionEnabled_ || pageGuarded)
         {
             CheckHeapCorruptionAtAddress(payloadAddr);
         }
 
-        /// Link this item out
-        mutex_.lock();
-        if (memoryAllocations_ == rec)
-            memoryAllocations_ = rec->next_;
-        if (rec->prev_)
-            rec->prev_->next_ = rec->next_;
-        if (rec->next_)
-            rec->next_->prev_ = rec->prev_;
-        --memoryAllocationCount_;
-        mutex_.unlock();
+        /// Sanity check: ensure that the shard index is valid
+        if (rec->shard_ >= kLeakTrackerShardCount)
+        {
+            std::cout << ("[memory] CORRUPTION: Attempting to free memory address with invalid memory allocation record (wrong shard).\n");
+            return;
+        }
+
+        /// Link this item out of the shard that registered it
+        {
+            Shard& shard = shards_[rec->shard_];
+            std::lock_guard<std::mutex> lk(shard.mutex);
+            if (shard.allocations == rec)
+                shard.allocations = rec->next_;
+            if (rec->prev_)
+                rec->prev_->next_ = rec->next_;
+            if (rec->next_)
+                rec->next_->prev_ = rec->prev_;
+            if (shard.scanCursor == rec)
+                shard.scanCursor = rec->next_;
+            --shard.count;
+
+            AddRelaxed(shard.freeCount, 1);
+            AddRelaxed(shard.liveBlocks[SizeClassOf(rec->size_)], ~uint64_t{ 0 }); // -1
+        }
+        currentBytes_.fetch_sub(rec->size_, std::memory_order_relaxed);
+        OnSiteFree(rec->site_, rec->size_);
+
+        if (QuarantineBytes_ != 0)
+        {
+            Quarantine(rec);
+            return;
+        }
+
+        ReleaseBlock(rec);
+    }
 
+    void LeakTracker::ReleaseBlock(MemoryAllocationRecord* rec) noexcept
+    {
         /// Free the address from the original alloc location (before mem allocation record)
-        free(mem);
+        unsigned char* payload = static_cast<unsigned char*>(rec->address_);
+        if (rec->flags_ & kRecordPageGuarded)
+            ReleaseGuardedPages(payload, rec->size_);
+        else
+            Memory::EngineFree(payload - sizeof(MemoryAllocationRecord) - (HeapCorruptionEnabled_ ? HeapCorruptionBuferSize_ : 0));
     }
 
-    void LeakTracker::PrintMemoryLeaks()
+    void LeakTracker::Quarantine(MemoryAllocationRecord* rec)
     {
-        printf("\n");
+        // ÿƬֵͬԤ㣻Ԥ㻹Ŀ鲻
+        const std::size_t shardBudget = QuarantineBytes_ / (ShardMask_ + 1);
+        if (rec->size_ > shardBudget)
+        {
+            ReleaseBlock(rec);
+            return;
+        }
 
-		LeakTracker_->mutex_.lock();
-        /// Dump general heap memory leaks
-		if (LeakTracker_->memoryAllocationCount_ == 0)
+        std::memset(rec->address_, kPoisonByte, rec->size_);
+
+        MemoryAllocationRecord* evicted = nullptr;
         {
-            LOG_INFO("[memory] All HEAP allocations successfully cleaned up (no leaks detected).");
+            Shard& shard = shards_[CurrentShard()];
+            std::lock_guard<std::mutex> lk(shard.mutex);
+            std::atomic_ref<unsigned int>(rec->flags_).fetch_or(kRecordQuarantined, std::memory_order_relaxed);
+            rec->next_ = nullptr;
+            if (shard.quarantineTail)
+                shard.quarantineTail->next_ = rec;
+            else
+                shard.quarantineHead = rec;
+            shard.quarantineTail = rec;
+            shard.quarantineBytes += rec->size_;
+
+            // ԤĲִӶժſԺټͷţ־Ҳڴ棩
+            MemoryAllocationRecord** evictedTail = &evicted;
+            while (shard.quarantineBytes > shardBudget)
+            {
+                MemoryAllocationRecord* oldest = shard.quarantineHead;
+                shard.quarantineHead = oldest->next_;
+                if (!shard.quarantineHead)
+                    shard.quarantineTail = nullptr;
+                shard.quarantineBytes -= oldest->size_;
+                *evictedTail = oldest;
+                evictedTail = &oldest->next_;
+            }
+            *evictedTail = nullptr;
         }
-        else
+
+        ReleaseQuarantined(evicted);
+    }
+
+    void LeakTracker::ReleaseQuarantined(MemoryAllocationRecord* records)
+    {
+        while (records)
         {
-            LOG_WARN("[memory] WARNING: %d  HEAP allocations still active in memory.", LeakTracker_->memoryAllocationCount_);
+            MemoryAllocationRecord* rec = records;
+            records = rec->next_;
 
-			MemoryAllocationRecord* rec = LeakTracker_->memoryAllocations_;
-            
-            while (rec)
+            const std::size_t offset = FindByteMismatch(static_cast<const unsigned char*>(rec->address_), rec->size_, kPoisonByte);
+            if (offset != rec->size_)
             {
-                if (strlen(rec->file_) > 0)
+                CBR_LOG(Memory, Warn, "[memory] USE AFTER FREE: address {} was written after it was freed, first modified byte at offset {}, size {}, {}:{}.",
+                    rec->address_, offset, rec->size_, (rec->file_ && *rec->file_) ? rec->file_ : "<operator new>", rec->line_);
+            }
+            // ԽдҲܷͷ֮
+            if (HeapCorruptionEnabled_ || (rec->flags_ & kRecordPageGuarded))
+                CheckHeapCorruptionAtAddress(rec->address_);
+
+            ReleaseBlock(rec);
+        }
+    }
+
+    void LeakTracker::DrainQuarantine()
+    {
+        for (Shard& shard : shards_)
+        {
+            MemoryAllocationRecord* records = nullptr;
+            {
+                std::lock_guard<std::mutex> lk(shard.mutex);
+                records = shard.quarantineHead;
+                shard.quarantineHead = nullptr;
+                shard.quarantineTail = nullptr;
+                shard.quarantineBytes = 0;
+            }
+            ReleaseQuarantined(records);
+        }
+    }
+
+    void LeakTracker::PrintMemoryLeaks()
+    {
+        printf("\n");
+
+        // վܣһվһУϢ͵ջ WriteAllocationReport ļ
+        struct LeakSite
+        {
+            const char* file;
+            unsigned int line;
+            uint64_t count;
+            uint64_t bytes;
+        };
+        std::vector<LeakSite> leaks;
+        uint64_t totalCount = 0;
+        uint64_t totalBytes = 0;
+
+        ForEachAllocationSite([&](const AllocationSite& site)
+            {
+                const uint64_t count = site.liveCount.load(std::memory_order_relaxed);
+                if (count == 0)
+                    return;
+
+                const uint64_t bytes = site.liveBytes.load(std::memory_order_relaxed);
+                totalCount += count;
+                totalBytes += bytes;
+                // ͬһ file:line Ĳͬջڿ̨Ϻϲ
+                auto it = std::find_if(leaks.begin(), leaks.end(), [&](const LeakSite& l) { return l.file == site.file && l.line == site.line; });
+                if (it != leaks.end())
+                {
+                    it->count += count;
+                    it->bytes += bytes;
+                }
+                else
                 {
-                    LOG_WARN("[memory] LEAK: At address %p, size %zu, %s:%u.\n", +rec->address_, rec->size_, rec->file_, rec->line_);
+                    leaks.push_back(LeakSite{ site.file, site.line, count, bytes });
                 }
-                rec = rec->next_;
+            });
+
+        /// Dump general heap memory leaks
+		if (totalCount == 0)
+        {
+            CBR_LOG(Memory, Info, "[memory] All HEAP allocations successfully cleaned up (no leaks detected).");
+            return;
+        }
+
+        CBR_LOG(Memory, Warn, "[memory] WARNING: {} HEAP allocations ({} bytes) still active in memory, from {} sites.", totalCount, totalBytes, leaks.size());
+
+        // ǩܣĸϵͳй©
+        uint64_t bytesByTag[Memory::kMemoryTagCount] = {};
+        for (Shard& shard : LeakTracker_->shards_)
+        {
+            std::lock_guard<std::mutex> lk(shard.mutex);
+            for (MemoryAllocationRecord* rec = shard.allocations; rec; rec = rec->next_)
+            {
+                bytesByTag[static_cast<std::size_t>(rec->tag_)] += rec->size_;
             }
         }
+        for (std::size_t i = 0; i < Memory::kMemoryTagCount; ++i)
+        {
+            if (bytesByTag[i] != 0)
+                CBR_LOG(Memory, Warn, "[memory] LEAK: {} bytes tagged {}.", bytesByTag[i], Memory::ToString(static_cast<Memory::MemoryTag>(i)));
+        }
+
+        std::sort(leaks.begin(), leaks.end(), [](const LeakSite& a, const LeakSite& b) { return a.bytes > b.bytes; });
+
+        constexpr std::size_t kMaxPrintedSites = 32;
+        for (std::size_t i = 0; i < leaks.size() && i < kMaxPrintedSites; ++i)
+        {
+            const LeakSite& leak = leaks[i];
+            CBR_LOG(Memory, Warn, "[memory] LEAK: {} blocks, {} bytes, {}:{}.", leak.count, leak.bytes, (leak.file && *leak.file) ? leak.file : "<operator new>", leak.line);
+        }
+        if (leaks.size() > kMaxPrintedSites)
+        {
+            CBR_LOG(Memory, Warn, "[memory] ... {} more sites{}", leaks.size() - kMaxPrintedSites, ReportPath_ ? ", see the allocation report." : ".");
+        }
+    }
 
-		LeakTracker_->mutex_.unlock();
+    bool LeakTracker::FindCorruption(MemoryAllocationRecord* rec, CorruptionReport& report) noexcept
+    {
+        unsigned char* payload = static_cast<unsigned char*>(rec->address_);
+        std::size_t before = kNoCorruption;
+        std::size_t after = kNoCorruption;
+
+        if (rec->flags_ & kRecordPageGuarded)
+        {
+            // ԽҳдѾ쳣ֻʣµļֽҪ
+            const std::size_t slack = GetGuardedLayout(rec->size_).payloadSpan - rec->size_;
+            if (const std::size_t offset = FindByteMismatch(payload + rec->size_, slack, 0); offset != slack)
+                after = offset;
+        }
+        else
+        {
+            const std::size_t guardSize = static_cast<std::size_t>(HeapCorruptionBuferSize_);
+            unsigned char* mem = payload - sizeof(MemoryAllocationRecord) - guardSize;
+            if (const std::size_t offset = FindByteMismatch(mem, guardSize, 0); offset != guardSize)
+                before = guardSize - offset + sizeof(MemoryAllocationRecord); // ǰڱûڴ֮ż¼ͷ
+            if (const std::size_t offset = FindByteMismatch(payload + rec->size_, guardSize, 0); offset != guardSize)
+                after = offset;
+        }
+        if (before == kNoCorruption && after == kNoCorruption)
+            return false;
+
+        // 顢 Free ٴͬһ飬ֻһ
+        if (std::atomic_ref<unsigned int>(rec->flags_).fetch_or(kRecordCorruptionReported, std::memory_order_relaxed) & kRecordCorruptionReported)
+            return false;
+
+        report = CorruptionReport{ rec->address_, rec->size_, rec->file_, rec->line_, before, after };
+        return true;
     }
 
-    void LeakTracker::CheckHeapCorruptionAtAddress(void* address)
+    void LeakTracker::ReportCorruption(const CorruptionReport& report)
     {
-        /// Backup passed in pointer to access memory allocation record
-        unsigned char* mem = ((unsigned char*)address) - sizeof(MemoryAllocationRecord) - HeapCorruptionBuferSize_;
+        const char* file = (report.file && *report.file) ? report.file : "<operator new>";
+        if (report.before != kNoCorruption)
+        {
+            CBR_LOG(Memory, Warn, "[memory] CORRUPTION: before address {}, first bad byte {} bytes before the block, size {}, {}:{}.",
+                report.address, report.before, report.size, file, report.line);
+        }
+        if (report.after != kNoCorruption)
+        {
+            CBR_LOG(Memory, Warn, "[memory] CORRUPTION: after address {}, first bad byte at offset {} past the end, size {}, {}:{}.",
+                report.address, report.after, report.size, file, report.line);
+        }
+    }
 
+    void LeakTracker::CheckHeapCorruptionAtAddress(void* address)
+    {
         MemoryAllocationRecord* rec = (MemoryAllocationRecord*)(((unsigned char*)address) - sizeof(MemoryAllocationRecord));
 
-        unsigned char* addrStart = mem;
-        unsigned char* addrEnd = addrStart + HeapCorruptionBuferSize_;
-        for (; addrStart < addrEnd; addrStart++)
+        CorruptionReport report;
+        if (FindCorruption(rec, report))
+            ReportCorruption(report);
+    }
+
+    std::size_t LeakTracker::CheckHeapCorruptionIncremental(std::chrono::steady_clock::time_point deadline)
+    {
+        // ÿƬһôͷſһʱ
+        constexpr std::size_t kBlocksPerSlice = 64;
+
+        std::size_t checked = 0;
+        for (unsigned int finishedShards = 0; finishedShards < kLeakTrackerShardCount; )
         {
-            if (*addrStart != 0)
+            Shard& shard = shards_[scanShard_];
+            CorruptionReport reports[kMaxReportsPerSlice];
+            std::size_t reportCount = 0;
+            bool finished = false;
             {
-                LOG_WARN("[memory] CORRUPTION: before address %p, size %zu, %s:%u.\n", rec->address_, rec->size_, rec->file_, rec->line_);
-                break;
+                std::lock_guard<std::mutex> lk(shard.mutex);
+                if (!shard.scanning)
+                {
+                    // µһִͷʼ·ĿͷһֲŻ鵽
+                    shard.scanCursor = shard.allocations;
+                    shard.scanning = true;
+                }
+                for (std::size_t i = 0; i < kBlocksPerSlice && shard.scanCursor && reportCount < kMaxReportsPerSlice; ++i)
+                {
+                    if (FindCorruption(shard.scanCursor, reports[reportCount]))
+                        ++reportCount;
+                    shard.scanCursor = shard.scanCursor->next_;
+                    ++checked;
+                }
+                finished = shard.scanCursor == nullptr;
+                shard.scanning = !finished;
             }
+
+            for (std::size_t i = 0; i < reportCount; ++i)
+            {
+                ReportCorruption(reports[i]);
+            }
+
+            if (finished)
+            {
+                scanShard_ = (scanShard_ + 1) & (kLeakTrackerShardCount - 1);
+                ++finishedShards;
+            }
+            if (std::chrono::steady_clock::now() >= deadline)
+                break;
         }
+        return checked;
+    }
 
-        addrStart = (unsigned char*)address + rec->size_;
-        addrEnd = addrStart + HeapCorruptionBuferSize_;
-        for (; addrStart < addrEnd; addrStart++)
+    void LeakTracker::CollectHeapStats(HeapStats& stats, uint64_t& bytesAllocated)
+    {
+        // Close ֮ LeakTracker_ ΪգѾٵĿȻ Free ¼
+        const LeakTracker* tracker = std::launder(reinterpret_cast<const LeakTracker*>(MemleakTracker_));
+        stats.currentBytes = tracker->currentBytes_.load(std::memory_order_relaxed);
+        stats.peakBytes = tracker->peakBytes_.load(std::memory_order_relaxed);
+
+        bytesAllocated = 0;
+        for (const Shard& shard : tracker->shards_)
         {
-            if (*addrStart != 0)
+            stats.totalAllocations += shard.allocationCount.load(std::memory_order_relaxed);
+            stats.totalFrees += shard.freeCount.load(std::memory_order_relaxed);
+            bytesAllocated += shard.bytesAllocated.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < kSizeClassCount; ++i)
             {
-                LOG_WARN("[memory] CORRUPTION: after address %p, size %zu, %s:%u.\n", rec->address_, rec->size_, rec->file_, rec->line_);
+                stats.liveBlocksBySizeClass[i] += shard.liveBlocks[i].load(std::memory_order_relaxed);
+                stats.allocationsBySizeClass[i] += shard.classAllocations[i].load(std::memory_order_relaxed);
             }
         }
+        // Ƭ֮䲻ͬһʱ̶ģͷʱڷ
+        stats.currentBlocks = stats.totalAllocations > stats.totalFrees ? stats.totalAllocations - stats.totalFrees : 0;
+    }
+
+    HeapStats GetHeapStats()
+    {
+        HeapStats stats;
+        uint64_t bytesAllocated = 0;
+        // FreeFuncPtr_  Init ֮һֱЧtracker Ҳһֱ MemleakTracker_ 
+        if (FreeFuncPtr_)
+            LeakTracker::CollectHeapStats(stats, bytesAllocated);
+
+        std::lock_guard<std::mutex> lk(FrameStatsMutex_);
+        stats.lastFrame = LastFrame_;
+        return stats;
+    }
+
+    void EndFrame()
+    {
+        if (!FreeFuncPtr_)
+            return;
+
+        HeapStats stats;
+        uint64_t bytesAllocated = 0;
+        LeakTracker::CollectHeapStats(stats, bytesAllocated);
+
+        std::unique_lock<std::mutex> lk(FrameStatsMutex_);
+        LastFrame_.frame = ++FrameTotals_.frame;
+        LastFrame_.allocations = stats.totalAllocations - FrameTotals_.allocations;
+        LastFrame_.frees = stats.totalFrees - FrameTotals_.frees;
+        LastFrame_.bytesAllocated = bytesAllocated - FrameTotals_.bytesAllocated;
+        FrameTotals_.allocations = stats.totalAllocations;
+        FrameTotals_.frees = stats.totalFrees;
+        FrameTotals_.bytesAllocated = bytesAllocated;
+        lk.unlock();
+
+        // к̨߳ʱ飬ռ֡ʱ
+        if (CheckBudget_.count() > 0 && !CheckerThread_.joinable())
+            CheckHeapCorruptionIncremental(CheckBudget_);
     }
 
     void LeakTracker::CheckHeapCorruption()
@@ -367,13 +1026,28 @@ namespace CBR::Engine::Debug::mlt
         if (!HeapCorruptionEnabled_)
             return;
 
-        MemoryAllocationRecord* rec = LeakTracker_->memoryAllocations_;
-                      
-        while (rec)
+        for (Shard& shard : LeakTracker_->shards_)
         {
-            LeakTracker_->CheckHeapCorruptionAtAddress(rec->address_);
+            for (bool rescan = true; rescan; )
+            {
+                CorruptionReport reports[kMaxReportsPerSlice];
+                std::size_t reportCount = 0;
+                {
+                    std::lock_guard<std::mutex> lk(shard.mutex);
+                    for (MemoryAllocationRecord* rec = shard.allocations; rec && reportCount < kMaxReportsPerSlice; rec = rec->next_)
+                    {
+                        if (FindCorruption(rec, reports[reportCount]))
+                            ++reportCount;
+                    }
+                }
+                // ˾ɨһ飬ѾĿбǣظ
+                rescan = reportCount == kMaxReportsPerSlice;
 
-            rec = rec->next_;
+                for (std::size_t i = 0; i < reportCount; ++i)
+                {
+                    ReportCorruption(reports[i]);
+                }
+            }
         }
     }
 } //CBR::Engine::Debug
@@ -386,10 +1060,16 @@ namespace CBR::Engine::Debug::mlt
 
 void* operator new (std::size_t size, const char* file, int line)
 {
+	CBR::Engine::Memory::OnOperatorNew(size, file, static_cast<unsigned int>(line));
+	void* p;
 	if(CBR::Engine::Debug::mlt::AllocFuncPtr_)
-		return CBR::Engine::Debug::mlt::AllocFuncPtr_(size, file, line);
+		p = CBR::Engine::Debug::mlt::AllocFuncPtr_(size, file, line);
 	else
-		return malloc(size);
+		p = CBR::Engine::Memory::EngineAlloc(size);
+	if (!p)
+		throw std::bad_alloc();
+	CBR::Engine::Debug::mlt::OnAllocation(p, size);
+	return p;
 }
 
 void* operator new[](std::size_t size, const char* file, int line)
@@ -418,7 +1098,14 @@ _Ret_maybenull_ _Success_(return != 0) _Post_writable_byte_size_(size)
 #endif
 void* operator new (std::size_t size, const std::nothrow_t&) noexcept
 {
-    return operator new (size, nullptr, 0);
+    try
+    {
+        return operator new (size, nullptr, 0);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
 }
 
 #ifdef _MSC_VER
@@ -426,39 +1113,50 @@ _Ret_maybenull_ _Success_(return != 0) _Post_writable_byte_size_(size)
 #endif
 void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
 {
-    return operator new (size, nullptr, 0);
+    try
+    {
+        return operator new (size, nullptr, 0);
+    }
+    catch (const std::bad_alloc&)
+    {
+        return nullptr;
+    }
 }
 
 void operator delete (void* p) noexcept
 {
+	CBR::Engine::Debug::mlt::OnDeallocation(p);
 	if(CBR::Engine::Debug::mlt::FreeFuncPtr_)
         CBR::Engine::Debug::mlt::FreeFuncPtr_(p);
 	else
-		free(p);
+		CBR::Engine::Memory::EngineFree(p);
 }
 
 void operator delete[](void* p) noexcept
 {
+	CBR::Engine::Debug::mlt::OnDeallocation(p);
 	if(CBR::Engine::Debug::mlt::FreeFuncPtr_)
         CBR::Engine::Debug::mlt::FreeFuncPtr_(p);
 	else
-		free(p);
+		CBR::Engine::Memory::EngineFree(p);
 }
 
 void operator delete (void* p, const char* file, int line) noexcept
 {
+	CBR::Engine::Debug::mlt::OnDeallocation(p);
 	if(CBR::Engine::Debug::mlt::FreeFuncPtr_)
         CBR::Engine::Debug::mlt::FreeFuncPtr_(p);
 	else
-		free(p);
+		CBR::Engine::Memory::EngineFree(p);
 }
 
 void operator delete[](void* p, const char* file, int line) noexcept
 {
+	CBR::Engine::Debug::mlt::OnDeallocation(p);
 	if(CBR::Engine::Debug::mlt::FreeFuncPtr_)
         CBR::Engine::Debug::mlt::FreeFuncPtr_(p);
 	else
-		free(p);
+		CBR::Engine::Memory::EngineFree(p);
 }
 
 #ifdef _MSC_VER
@@ -472,7 +1170,7 @@ namespace CBR::Engine::Debug::mlt
 		if(Debug::mlt::AllocFuncPtr_)
 			return Debug::mlt::AllocFuncPtr_(size, nullptr, 0);
 		else
-			return malloc(size);
+			return Memory::EngineAlloc(size);
 	}
 
     void BaseLeakTracker::operator delete(void* p)
@@ -480,7 +1178,7 @@ namespace CBR::Engine::Debug::mlt
 		if(Debug::mlt::FreeFuncPtr_)
             Debug::mlt::FreeFuncPtr_(p);
 		else
-			free(p);
+			Memory::EngineFree(p);
     }
 
     void* BaseLeakTracker::operator new[](size_t size)
@@ -488,7 +1186,7 @@ namespace CBR::Engine::Debug::mlt
 		if(Debug::mlt::AllocFuncPtr_)
 			return Debug::mlt::AllocFuncPtr_(size, nullptr, 0);
 		else
-			return malloc(size);
+			return Memory::EngineAlloc(size);
     }
 
     void BaseLeakTracker::operator delete[](void* p)
@@ -496,7 +1194,7 @@ namespace CBR::Engine::Debug::mlt
 		if(Debug::mlt::FreeFuncPtr_)
             Debug::mlt::FreeFuncPtr_(p);
 		else
-			free(p);
+			Memory::EngineFree(p);
 	};
 
     void* BaseLeakTracker::operator new(size_t size, const char *file, int line)
@@ -504,7 +1202,7 @@ namespace CBR::Engine::Debug::mlt
 		if(Debug::mlt::AllocFuncPtr_)
 			return Debug::mlt::AllocFuncPtr_(size, file, line);
 		else
-			return malloc(size);
+			return Memory::EngineAlloc(size);
 	};
 
     void BaseLeakTracker::operator delete(void* p, const char *file, int line)
@@ -512,7 +1210,7 @@ namespace CBR::Engine::Debug::mlt
 		if(Debug::mlt::FreeFuncPtr_)
             Debug::mlt::FreeFuncPtr_(p);
 		else
-			free(p);
+			Memory::EngineFree(p);
 	};
 
     void* BaseLeakTracker::operator new[](size_t size, const char *file, int line)
@@ -520,7 +1218,7 @@ namespace CBR::Engine::Debug::mlt
 		if(Debug::mlt::AllocFuncPtr_)
 			return Debug::mlt::AllocFuncPtr_(size, file, line);
 		else
-			return malloc(size);
+			return Memory::EngineAlloc(size);
 	}
 
     void BaseLeakTracker::operator delete[](void* p, const char *file, int line)
@@ -528,7 +1226,64 @@ namespace CBR::Engine::Debug::mlt
 		if(Debug::mlt::FreeFuncPtr_)
             Debug::mlt::FreeFuncPtr_(p);
 		else
-			free(p);
+			Memory::EngineFree(p);
 	};
 } // namespace CBR::Engine::Debug::mlt
+
+#else //!_DEBUG
+
+// Release ûй©٣ȫ new/delete ֱĶѣMemory::EngineAllocֻMemorySampler.hһڡ
+// ûпʱÿηͷֻһԭӱ
+
+#ifdef _MSC_VER
+_Ret_notnull_ _Post_writable_byte_size_(size)
+#endif
+void* operator new (std::size_t size) noexcept(false)
+{
+    CBR::Engine::Memory::OnOperatorNew(size, nullptr, 0);
+    void* p = CBR::Engine::Memory::EngineAlloc(size);
+    if (!p)
+        throw std::bad_alloc();
+    CBR::Engine::Debug::mlt::OnAllocation(p, size);
+    return p;
+}
+
+#ifdef _MSC_VER
+_Ret_notnull_ _Post_writable_byte_size_(size)
+#endif
+void* operator new[](std::size_t size) noexcept(false)
+{
+    return operator new (size);
+}
+
+#ifdef _MSC_VER
+_Ret_maybenull_ _Success_(return != 0) _Post_writable_byte_size_(size)
+#endif
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    CBR::Engine::Memory::OnOperatorNew(size, nullptr, 0);
+    void* p = CBR::Engine::Memory::EngineAlloc(size);
+    CBR::Engine::Debug::mlt::OnAllocation(p, size);
+    return p;
+}
+
+#ifdef _MSC_VER
+_Ret_maybenull_ _Success_(return != 0) _Post_writable_byte_size_(size)
+#endif
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new (size, tag);
+}
+
+void operator delete (void* p) noexcept
+{
+    CBR::Engine::Debug::mlt::OnDeallocation(p);
+    CBR::Engine::Memory::EngineFree(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    CBR::Engine::Debug::mlt::OnDeallocation(p);
+    CBR::Engine::Memory::EngineFree(p);
+}
 #endif //_DEBUG
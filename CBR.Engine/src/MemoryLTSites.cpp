@@ -0,0 +1,210 @@
+#include "pch.h"
+#include "Engine/Debug/MemoryLT.h"
+#include "Engine/Debug/MemoryLTSites.h"
+#include "Engine/Debug/StackTrace.h"
+
+#if defined(_DEBUG) || defined(DEBUG)
+
+#if defined new
+#undef new
+#endif
+
+namespace CBR::Engine::Debug::mlt
+{
+    namespace
+    {
+        constexpr std::size_t kMaxAllocationSites = 16384; // 2
+
+        AllocationSite* Sites_ = nullptr;
+        AllocationSite OverflowSite_;
+        std::once_flag SitesOnce_;
+
+        uint64_t HashSite(const char* file, unsigned int line, void* const* frames, uint16_t depth) noexcept
+        {
+            // FNV-1aļָ㣨ͬһ __FILE__ ַͬ
+            uint64_t hash = 14695981039346656037ull;
+            auto mix = [&hash](uint64_t value)
+                {
+                    for (int i = 0; i < 8; ++i)
+                    {
+                        hash = (hash ^ ((value >> (i * 8)) & 0xFF)) * 1099511628211ull;
+                    }
+                };
+            mix(reinterpret_cast<uintptr_t>(file));
+            mix(line);
+            for (uint16_t i = 0; i < depth; ++i)
+            {
+                mix(reinterpret_cast<uintptr_t>(frames[i]));
+            }
+            return hash | 1; // 0 ղ
+        }
+
+        bool SameSite(const AllocationSite& site, const char* file, unsigned int line, void* const* frames, uint16_t depth) noexcept
+        {
+            return site.file == file && site.line == line && site.depth == depth
+                && std::equal(frames, frames + depth, site.frames);
+        }
+
+        void UpdateMax(std::atomic<uint64_t>& target, uint64_t value) noexcept
+        {
+            uint64_t current = target.load(std::memory_order_relaxed);
+            while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+    }
+
+    void InitAllocationSites()
+    {
+        std::call_once(SitesOnce_, []
+            {
+                //  calloc  newٵ operator new
+                void* memory = std::calloc(kMaxAllocationSites, sizeof(AllocationSite));
+                if (!memory)
+                    return;
+
+                Sites_ = static_cast<AllocationSite*>(memory);
+                for (std::size_t i = 0; i < kMaxAllocationSites; ++i)
+                {
+                    ::new (&Sites_[i]) AllocationSite();
+                }
+
+                OverflowSite_.file = "<site table full>";
+                OverflowSite_.key.store(1, std::memory_order_relaxed);
+                OverflowSite_.ready.store(true, std::memory_order_release);
+            });
+    }
+
+    AllocationSite* InternAllocationSite(const char* file, unsigned int line, void* const* frames, uint16_t depth) noexcept
+    {
+        if (!Sites_)
+            return &OverflowSite_;
+
+        const uint64_t key = HashSite(file, line, frames, depth);
+        std::size_t slot = static_cast<std::size_t>(key) & (kMaxAllocationSites - 1);
+
+        // Ѱַֻ벻ɾԲҺͲ붼Ҫ
+        for (std::size_t probe = 0; probe < kMaxAllocationSites; ++probe)
+        {
+            AllocationSite& site = Sites_[slot];
+            uint64_t current = site.key.load(std::memory_order_acquire);
+
+            if (current == 0)
+            {
+                if (site.key.compare_exchange_strong(current, key, std::memory_order_acq_rel))
+                {
+                    site.file = file;
+                    site.line = line;
+                    site.depth = depth;
+                    std::copy(frames, frames + depth, site.frames);
+                    site.ready.store(true, std::memory_order_release);
+                    return &site;
+                }
+                // ߳ȣcurrent д keyűȽ
+            }
+
+            if (current == key)
+            {
+                // ۵̻߳дֶ
+                while (!site.ready.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                if (SameSite(site, file, line, frames, depth))
+                    return &site;
+            }
+
+            slot = (slot + 1) & (kMaxAllocationSites - 1);
+        }
+        return &OverflowSite_;
+    }
+
+    void OnSiteAlloc(AllocationSite* site, std::size_t size) noexcept
+    {
+        site->totalCount.fetch_add(1, std::memory_order_relaxed);
+        site->totalBytes.fetch_add(size, std::memory_order_relaxed);
+        site->liveCount.fetch_add(1, std::memory_order_relaxed);
+        const uint64_t live = site->liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        UpdateMax(site->peakBytes, live);
+    }
+
+    void OnSiteFree(AllocationSite* site, std::size_t size) noexcept
+    {
+        site->liveCount.fetch_sub(1, std::memory_order_relaxed);
+        site->liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    void ForEachAllocationSite(const std::function<void(const AllocationSite&)>& callback)
+    {
+        if (Sites_)
+        {
+            for (std::size_t i = 0; i < kMaxAllocationSites; ++i)
+            {
+                const AllocationSite& site = Sites_[i];
+                if (site.ready.load(std::memory_order_acquire))
+                    callback(site);
+            }
+        }
+        if (OverflowSite_.totalCount.load(std::memory_order_relaxed) != 0)
+            callback(OverflowSite_);
+    }
+
+    bool WriteAllocationReport(const char* path)
+    {
+        if (!path || !*path)
+            return false;
+
+        // ŽDbgHelp̰߳ȫ
+        static std::mutex reportMutex;
+        std::lock_guard<std::mutex> lk(reportMutex);
+
+        std::vector<const AllocationSite*> sites;
+        ForEachAllocationSite([&sites](const AllocationSite& site) { sites.push_back(&site); });
+
+        // ֽڶǰй©ۼƷ
+        std::sort(sites.begin(), sites.end(), [](const AllocationSite* a, const AllocationSite* b)
+            {
+                const uint64_t liveA = a->liveBytes.load(std::memory_order_relaxed);
+                const uint64_t liveB = b->liveBytes.load(std::memory_order_relaxed);
+                if (liveA != liveB)
+                    return liveA > liveB;
+                return a->totalBytes.load(std::memory_order_relaxed) > b->totalBytes.load(std::memory_order_relaxed);
+            });
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file)
+            return false;
+
+        uint64_t liveCount = 0, liveBytes = 0;
+        for (const AllocationSite* site : sites)
+        {
+            liveCount += site->liveCount.load(std::memory_order_relaxed);
+            liveBytes += site->liveBytes.load(std::memory_order_relaxed);
+        }
+
+        file << "# CBR allocation report\n";
+        file << "# sites " << sites.size() << ", live blocks " << liveCount << ", live bytes " << liveBytes << "\n";
+        file << "# live_blocks live_bytes peak_bytes total_allocs total_bytes location\n\n";
+
+        for (const AllocationSite* site : sites)
+        {
+            const char* location = (site->file && *site->file) ? site->file : "<operator new>";
+            file << std::format("{} {} {} {} {} {}:{}\n",
+                site->liveCount.load(std::memory_order_relaxed),
+                site->liveBytes.load(std::memory_order_relaxed),
+                site->peakBytes.load(std::memory_order_relaxed),
+                site->totalCount.load(std::memory_order_relaxed),
+                site->totalBytes.load(std::memory_order_relaxed),
+                location, site->line);
+
+            for (uint16_t i = 0; i < site->depth; ++i)
+            {
+                file << "    at " << DescribeFrame(site->frames[i]) << '\n';
+            }
+            file << '\n';
+        }
+        return static_cast<bool>(file);
+    }
+} // namespace CBR::Engine::Debug::mlt
+
+#endif //_DEBUG
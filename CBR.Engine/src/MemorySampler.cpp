@@ -0,0 +1,303 @@
+#include "pch.h"
+#include "Engine/Debug/MemorySampler.h"
+#include "Engine/Debug/StackTrace.h"
+
+namespace CBR::Engine::Debug::mlt
+{
+    namespace sampler
+    {
+        std::atomic<bool> g_enabled{ false };
+        std::atomic<uint32_t> g_liveSamples{ 0 };
+        thread_local int64_t t_bytesUntilSample = 0;
+    }
+
+    namespace
+    {
+        constexpr std::size_t kSampleSlots = 16384;               // 2
+        constexpr std::size_t kMaxLiveSamples = kSampleSlots / 2; // װʲһ룬鲻ĵַƽֻ
+
+        struct Sample
+        {
+            std::size_t size;
+            double weight; // ķƣ
+            uint16_t depth;
+            void* frames[kMaxStackDepth];
+        };
+
+        // ַһ飬delete ʱֻһ顣̽⣬ɾʱѺǰƣĹ
+        // ƶڼ TableVersion_ ĲҾݴжûкƶ
+        std::atomic<void*> SampleKeys_[kSampleSlots];
+        Sample Samples_[kSampleSlots];
+        std::atomic<uint32_t> TableVersion_{ 0 };
+
+        // ǰһˣַһιϣΪ 0 ʱһǲĵַ
+        // 16KB ڻ delete ֻһֽ
+        constexpr std::size_t kFilterSize = 16384;
+        std::atomic<uint8_t> SampleFilter_[kFilterSize];
+
+        // ֻбķͷŲŻдڴ棬Ҳ̬˳
+        std::atomic_flag TableLock_ = ATOMIC_FLAG_INIT;
+
+        std::atomic<std::size_t> IntervalBytes_{ SamplerConfig{}.sampleIntervalBytes };
+        std::atomic<uint16_t> StackDepth_{ static_cast<uint16_t>(SamplerConfig{}.stackDepth) };
+        std::atomic<uint64_t> TotalSamples_{ 0 };
+        std::atomic<uint64_t> DroppedSamples_{ 0 };
+
+        thread_local uint64_t t_random = 0;
+
+        class TableLockGuard
+        {
+        public:
+            TableLockGuard() noexcept
+            {
+                while (TableLock_.test_and_set(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            ~TableLockGuard() { TableLock_.clear(std::memory_order_release); }
+        };
+
+        uint64_t MixAddress(const void* address) noexcept
+        {
+            // ĵַλ 0Ȼһ
+            uint64_t x = reinterpret_cast<uintptr_t>(address);
+            x ^= x >> 33;
+            x *= 0xFF51AFD7ED558CCDull;
+            x ^= x >> 33;
+            return x;
+        }
+
+        std::size_t HomeSlot(const void* address) noexcept
+        {
+            return static_cast<std::size_t>(MixAddress(address)) & (kSampleSlots - 1);
+        }
+
+        std::atomic<uint8_t>& FilterCounter(const void* address) noexcept
+        {
+            return SampleFilter_[static_cast<std::size_t>(MixAddress(address) >> 32) & (kFilterSize - 1)];
+        }
+
+        //  address ڵĲۣûʱ kSampleSlots÷ TableVersion_
+        std::size_t FindSlot(const void* address) noexcept
+        {
+            std::size_t slot = HomeSlot(address);
+            for (std::size_t probe = 0; probe < kSampleSlots; ++probe)
+            {
+                const void* key = SampleKeys_[slot].load(std::memory_order_relaxed);
+                if (key == address)
+                    return slot;
+                if (key == nullptr)
+                    break;
+                slot = (slot + 1) & (kSampleSlots - 1);
+            }
+            return kSampleSlots;
+        }
+
+        //  TableLock_ ʱãһ۲ͬһ̽Ϻǰ
+        void EraseSlot(std::size_t hole) noexcept
+        {
+            TableVersion_.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::size_t slot = hole;
+            for (;;)
+            {
+                slot = (slot + 1) & (kSampleSlots - 1);
+                void* key = SampleKeys_[slot].load(std::memory_order_relaxed);
+                if (key == nullptr)
+                    break;
+
+                // һʼ۲ (hole, slot] ֮ʱƵ hole
+                const std::size_t home = HomeSlot(key);
+                const bool reachable = hole <= slot ? (hole < home && home <= slot) : (hole < home || home <= slot);
+                if (reachable)
+                    continue;
+
+                Samples_[hole] = Samples_[slot];
+                SampleKeys_[hole].store(key, std::memory_order_relaxed);
+                hole = slot;
+            }
+            SampleKeys_[hole].store(nullptr, std::memory_order_relaxed);
+
+            TableVersion_.fetch_add(1, std::memory_order_release);
+        }
+
+        double NextUniform() noexcept
+        {
+            // xorshift64*ÿ߳һݣҪͬ
+            if (t_random == 0)
+                t_random = (reinterpret_cast<uintptr_t>(&t_random) ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())) | 1;
+            t_random ^= t_random >> 12;
+            t_random ^= t_random << 25;
+            t_random ^= t_random >> 27;
+            return static_cast<double>((t_random * 0x2545F4914F6CDD1Dull) >> 11) * 0x1.0p-53;
+        }
+
+        int64_t NextSampleDistance() noexcept
+        {
+            // ֲָÿֽڱѡеĸͬͷĴС˳޹
+            const double mean = static_cast<double>(IntervalBytes_.load(std::memory_order_relaxed));
+            return static_cast<int64_t>(-std::log(1.0 - NextUniform()) * mean) + 1;
+        }
+    }
+
+    void StartSampling(const SamplerConfig& config)
+    {
+        IntervalBytes_.store(std::max<std::size_t>(config.sampleIntervalBytes, 1), std::memory_order_relaxed);
+        StackDepth_.store(static_cast<uint16_t>(std::clamp<int>(config.stackDepth, 1, static_cast<int>(kMaxStackDepth))), std::memory_order_relaxed);
+        sampler::g_enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void StopSampling()
+    {
+        sampler::g_enabled.store(false, std::memory_order_relaxed);
+    }
+
+    bool IsSampling() noexcept
+    {
+        return sampler::g_enabled.load(std::memory_order_relaxed);
+    }
+
+    void sampler::RecordSample(void* address, std::size_t size) noexcept
+    {
+        // ̵߳ĵһηֻȷһ
+        const bool firstCall = t_random == 0;
+        t_bytesUntilSample = NextSampleDistance();
+        if (firstCall || !address)
+            return;
+
+        Sample sample;
+        sample.size = size;
+        // СΪ size ķ䱻ѡеĸ 1 - e^(-size/interval)ȡõķ
+        const double probability = -std::expm1(-static_cast<double>(size) / static_cast<double>(IntervalBytes_.load(std::memory_order_relaxed)));
+        sample.weight = probability > 0.0 ? 1.0 / probability : 1.0;
+        //  RecordSampleOnAllocation ͨ operator newһ֡ operator new
+        sample.depth = CaptureStack(sample.frames, StackDepth_.load(std::memory_order_relaxed), 1);
+
+        TableLockGuard lock;
+        std::atomic<uint8_t>& filter = FilterCounter(address);
+        const uint8_t filterCount = filter.load(std::memory_order_relaxed);
+        if (g_liveSamples.load(std::memory_order_relaxed) >= kMaxLiveSamples || filterCount == std::numeric_limits<uint8_t>::max())
+        {
+            DroppedSamples_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // ַҪ operator new ԺŻᱻͷţͷŵһһܿμ
+        filter.store(filterCount + 1, std::memory_order_relaxed);
+
+        // µֻŽղۣƶҪİ汾
+        std::size_t slot = HomeSlot(address);
+        while (SampleKeys_[slot].load(std::memory_order_relaxed) != nullptr)
+        {
+            slot = (slot + 1) & (kSampleSlots - 1);
+        }
+        Samples_[slot] = sample;
+        SampleKeys_[slot].store(address, std::memory_order_release);
+        g_liveSamples.fetch_add(1, std::memory_order_relaxed);
+        TotalSamples_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void sampler::ReleaseSample(void* address) noexcept
+    {
+        std::atomic<uint8_t>& filter = FilterCounter(address);
+        if (filter.load(std::memory_order_relaxed) == 0)
+            return;
+
+        // 󱨣һɾƶûнͿֱӷ
+        for (;;)
+        {
+            const uint32_t version = TableVersion_.load(std::memory_order_acquire);
+            if ((version & 1) == 0)
+            {
+                const bool found = FindSlot(address) != kSampleSlots;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (!found && TableVersion_.load(std::memory_order_relaxed) == version)
+                    return;
+                if (found)
+                    break;
+            }
+            std::this_thread::yield();
+        }
+
+        TableLockGuard lock;
+        if (const std::size_t slot = FindSlot(address); slot != kSampleSlots)
+        {
+            filter.store(filter.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+            EraseSlot(slot);
+            g_liveSamples.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    bool WriteSampledProfile(const char* path)
+    {
+        if (!path || !*path)
+            return false;
+
+        // ȷãбʱܷڴ棨operator new Ҫ
+        std::vector<Sample> samples;
+        samples.reserve(kMaxLiveSamples);
+        {
+            TableLockGuard lock;
+            for (std::size_t i = 0; i < kSampleSlots && samples.size() < samples.capacity(); ++i)
+            {
+                if (SampleKeys_[i].load(std::memory_order_relaxed) != nullptr)
+                    samples.push_back(Samples_[i]);
+            }
+        }
+
+        // ͬһջϲ
+        struct StackProfile
+        {
+            const Sample* sample;
+            double bytes;
+            double count;
+            uint64_t samples;
+        };
+        auto sameStack = [](const Sample& a, const Sample& b)
+            {
+                return a.depth == b.depth && std::equal(a.frames, a.frames + a.depth, b.frames);
+            };
+        auto stackLess = [](const Sample& a, const Sample& b)
+            {
+                return std::lexicographical_compare(a.frames, a.frames + a.depth, b.frames, b.frames + b.depth, std::less<void*>());
+            };
+        std::sort(samples.begin(), samples.end(), stackLess);
+
+        std::vector<StackProfile> stacks;
+        double liveBytes = 0.0;
+        for (const Sample& sample : samples)
+        {
+            const double bytes = static_cast<double>(sample.size) * sample.weight;
+            liveBytes += bytes;
+            if (stacks.empty() || !sameStack(*stacks.back().sample, sample))
+                stacks.push_back(StackProfile{ &sample, 0.0, 0.0, 0 });
+            stacks.back().bytes += bytes;
+            stacks.back().count += sample.weight;
+            ++stacks.back().samples;
+        }
+        std::sort(stacks.begin(), stacks.end(), [](const StackProfile& a, const StackProfile& b) { return a.bytes > b.bytes; });
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file)
+            return false;
+
+        file << "# CBR sampled heap profile\n";
+        file << "# interval " << IntervalBytes_.load(std::memory_order_relaxed) << " bytes, live samples " << samples.size()
+             << ", total samples " << TotalSamples_.load(std::memory_order_relaxed)
+             << ", dropped " << DroppedSamples_.load(std::memory_order_relaxed) << "\n";
+        file << "# estimated live bytes " << static_cast<uint64_t>(liveBytes) << "\n";
+        file << "# est_live_bytes est_live_blocks samples\n\n";
+
+        for (const StackProfile& stack : stacks)
+        {
+            file << static_cast<uint64_t>(stack.bytes) << ' ' << static_cast<uint64_t>(stack.count + 0.5) << ' ' << stack.samples << '\n';
+            for (uint16_t i = 0; i < stack.sample->depth; ++i)
+            {
+                file << "    at " << DescribeFrame(stack.sample->frames[i]) << '\n';
+            }
+            file << '\n';
+        }
+        return static_cast<bool>(file);
+    }
+} // namespace CBR::Engine::Debug::mlt
@@ -0,0 +1,131 @@
+#include "pch.h"
+#include "Engine/Debug/MemoryLT.h"
+#include "Engine/Debug/MemoryLTSites.h"
+#include "Engine/Debug/MemoryStats.h"
+#include "Engine/Debug/Logger.h"
+
+#if defined(_DEBUG) || defined(DEBUG)
+
+namespace CBR::Engine::Debug::mlt
+{
+    namespace
+    {
+        SiteStats ToSiteStats(const AllocationSite& site)
+        {
+            SiteStats stats;
+            stats.id = &site;
+            stats.file = site.file;
+            stats.line = site.line;
+            stats.stackDepth = site.depth;
+            stats.liveCount = site.liveCount.load(std::memory_order_relaxed);
+            stats.liveBytes = site.liveBytes.load(std::memory_order_relaxed);
+            stats.peakBytes = site.peakBytes.load(std::memory_order_relaxed);
+            stats.totalCount = site.totalCount.load(std::memory_order_relaxed);
+            stats.totalBytes = site.totalBytes.load(std::memory_order_relaxed);
+            return stats;
+        }
+
+        uint64_t SortValue(const SiteStats& site, SiteSortKey sortKey)
+        {
+            switch (sortKey)
+            {
+            case SiteSortKey::PeakBytes: return site.peakBytes;
+            case SiteSortKey::TotalBytes: return site.totalBytes;
+            case SiteSortKey::TotalCount: return site.totalCount;
+            case SiteSortKey::LiveBytes:
+            default: return site.liveBytes;
+            }
+        }
+
+        const char* SiteLocation(const SiteStats& site)
+        {
+            return (site.file && *site.file) ? site.file : "<operator new>";
+        }
+    }
+
+    std::vector<SiteStats> GetTopSites(std::size_t count, SiteSortKey sortKey)
+    {
+        std::vector<SiteStats> sites;
+        if (count == 0)
+            return sites;
+
+        ForEachAllocationSite([&sites](const AllocationSite& site) { sites.push_back(ToSiteStats(site)); });
+
+        auto greater = [sortKey](const SiteStats& a, const SiteStats& b) { return SortValue(a, sortKey) > SortValue(b, sortKey); };
+        if (sites.size() > count)
+        {
+            std::partial_sort(sites.begin(), sites.begin() + count, sites.end(), greater);
+            sites.resize(count);
+        }
+        else
+        {
+            std::sort(sites.begin(), sites.end(), greater);
+        }
+        return sites;
+    }
+
+    Snapshot TakeSnapshot()
+    {
+        Snapshot snapshot;
+        snapshot.time = std::chrono::steady_clock::now();
+        snapshot.heap = GetHeapStats();
+        ForEachAllocationSite([&snapshot](const AllocationSite& site) { snapshot.sites.push_back(ToSiteStats(site)); });
+
+        // վֻɾ id ź DiffSnapshots Ժϲ
+        std::sort(snapshot.sites.begin(), snapshot.sites.end(), [](const SiteStats& a, const SiteStats& b) { return std::less<const void*>()(a.id, b.id); });
+        return snapshot;
+    }
+
+    SnapshotDiff DiffSnapshots(const Snapshot& before, const Snapshot& after)
+    {
+        SnapshotDiff diff;
+        diff.elapsed = after.time - before.time;
+        diff.currentBytes = static_cast<int64_t>(after.heap.currentBytes) - static_cast<int64_t>(before.heap.currentBytes);
+        diff.currentBlocks = static_cast<int64_t>(after.heap.currentBlocks) - static_cast<int64_t>(before.heap.currentBlocks);
+        diff.allocations = after.heap.totalAllocations - before.heap.totalAllocations;
+        diff.frees = after.heap.totalFrees - before.heap.totalFrees;
+
+        const std::less<const void*> less;
+        auto prev = before.sites.begin();
+        for (const SiteStats& site : after.sites)
+        {
+            while (prev != before.sites.end() && less(prev->id, site.id))
+                ++prev;
+
+            // ǰһûеվʱ³ֵ
+            const bool existed = prev != before.sites.end() && prev->id == site.id;
+            SiteDelta delta;
+            delta.site = site;
+            delta.liveBytes = static_cast<int64_t>(site.liveBytes) - static_cast<int64_t>(existed ? prev->liveBytes : 0);
+            delta.liveCount = static_cast<int64_t>(site.liveCount) - static_cast<int64_t>(existed ? prev->liveCount : 0);
+            delta.allocations = site.totalCount - (existed ? prev->totalCount : 0);
+
+            if (delta.liveBytes != 0 || delta.liveCount != 0 || delta.allocations != 0)
+                diff.sites.push_back(delta);
+        }
+
+        std::sort(diff.sites.begin(), diff.sites.end(), [](const SiteDelta& a, const SiteDelta& b)
+            {
+                if (a.liveBytes != b.liveBytes)
+                    return a.liveBytes > b.liveBytes;
+                return a.allocations > b.allocations;
+            });
+        return diff;
+    }
+
+    void LogSnapshotDiff(const SnapshotDiff& diff, std::size_t topN)
+    {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(diff.elapsed);
+        CBR_LOG(Memory, Info, "[memory] Snapshot diff over {} ms: {:+} bytes, {:+} blocks, {} allocations, {} frees, {} sites changed.",
+            elapsed.count(), diff.currentBytes, diff.currentBlocks, diff.allocations, diff.frees, diff.sites.size());
+
+        for (std::size_t i = 0; i < diff.sites.size() && i < topN; ++i)
+        {
+            const SiteDelta& delta = diff.sites[i];
+            CBR_LOG(Memory, Info, "[memory]   {:+} bytes, {:+} blocks, {} allocations, {}:{}.",
+                delta.liveBytes, delta.liveCount, delta.allocations, SiteLocation(delta.site), delta.site.line);
+        }
+    }
+} // namespace CBR::Engine::Debug::mlt
+
+#endif //_DEBUG
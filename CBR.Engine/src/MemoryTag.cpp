@@ -0,0 +1,216 @@
+#include "pch.h"
+#include "Engine/Memory/MemoryTag.h"
+#include "Engine/Memory/MemoryTagTracking.h"
+#include "Engine/Debug/Logger.h"
+#include "Engine/Utility/Environment.h"
+
+// ȫ operator new £ȫ״̬ǳʼģܷڴ
+
+namespace CBR::Engine::Memory
+{
+    namespace tagging
+    {
+        constinit thread_local MemoryTag t_currentTag = MemoryTag::Untagged;
+        constinit thread_local ThreadCounters* t_counters = nullptr;
+    }
+
+    namespace
+    {
+        // ͬʱڵ̳߳ʱֱ߳ӸȫּԭӼӣһЩȻȷ
+        constexpr std::size_t kMaxCounterThreads = 128;
+
+        tagging::ThreadCounters CounterSlots_[kMaxCounterThreads];
+        std::atomic<bool> CounterSlotUsed_[kMaxCounterThreads];
+        // Ѿ˳̺߳ϲ
+        std::atomic<int64_t> RetiredBytes_[kMemoryTagCount];
+
+        struct Budget
+        {
+            std::atomic<std::size_t> bytes{ 0 };
+            std::atomic<MemoryBudgetAction> action{ MemoryBudgetAction::Warn };
+            bool exceeded = false; // ֻ CheckMemoryBudgetṣ߳д
+        };
+        Budget Budgets_[kMemoryTagCount];
+
+        thread_local bool t_retired = false;
+
+        struct CounterReleaser
+        {
+            bool active = false;
+
+            ~CounterReleaser()
+            {
+                if (!active)
+                    return;
+
+                tagging::ThreadCounters* counters = tagging::t_counters;
+                tagging::t_counters = nullptr;
+                t_retired = true;
+                for (std::size_t i = 0; i < kMemoryTagCount; ++i)
+                {
+                    RetiredBytes_[i].fetch_add(counters->liveBytes[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    counters->liveBytes[i].store(0, std::memory_order_relaxed);
+                }
+                CounterSlotUsed_[counters - CounterSlots_].store(false, std::memory_order_release);
+            }
+        };
+
+        thread_local CounterReleaser t_releaser;
+
+        // "64M""512k""1G""1000"ֽڣ
+        std::optional<std::size_t> ParseBytes(std::string_view text) noexcept
+        {
+            std::size_t value = 0;
+            const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+            if (ec != std::errc() || end == text.data())
+                return std::nullopt;
+
+            std::string_view suffix = Utility::Trim(std::string_view(end, text.data() + text.size() - end));
+            if (!suffix.empty() && (suffix.back() == 'B' || suffix.back() == 'b'))
+                suffix.remove_suffix(1);
+            if (suffix.empty())
+                return value;
+            if (suffix.size() != 1)
+                return std::nullopt;
+
+            switch (std::toupper(static_cast<unsigned char>(suffix.front())))
+            {
+            case 'K': return value << 10;
+            case 'M': return value << 20;
+            case 'G': return value << 30;
+            default: return std::nullopt;
+            }
+        }
+    }
+
+    void tagging::AddSlow(MemoryTag tag, int64_t bytes) noexcept
+    {
+        if (!t_retired)
+        {
+            for (std::size_t i = 0; i < kMaxCounterThreads; ++i)
+            {
+                if (!CounterSlotUsed_[i].load(std::memory_order_relaxed) && !CounterSlotUsed_[i].exchange(true, std::memory_order_acquire))
+                {
+                    t_counters = &CounterSlots_[i];
+                    t_releaser.active = true; // һηʱǼ߳˳ʱĺϲ
+                    Add(tag, bytes);
+                    return;
+                }
+            }
+        }
+        RetiredBytes_[static_cast<std::size_t>(tag)].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    MemoryTagScope::MemoryTagScope(MemoryTag tag) noexcept
+        : previous_(tagging::t_currentTag)
+    {
+        tagging::t_currentTag = tag;
+    }
+
+    MemoryTagScope::~MemoryTagScope()
+    {
+        tagging::t_currentTag = previous_;
+    }
+
+    MemoryTag GetCurrentMemoryTag() noexcept
+    {
+        return tagging::t_currentTag;
+    }
+
+    void SetMemoryBudget(MemoryTag tag, std::size_t bytes, MemoryBudgetAction action) noexcept
+    {
+        Budget& budget = Budgets_[static_cast<std::size_t>(tag)];
+        budget.action.store(action, std::memory_order_relaxed);
+        budget.bytes.store(bytes, std::memory_order_relaxed);
+    }
+
+    std::size_t GetMemoryBudget(MemoryTag tag) noexcept
+    {
+        return Budgets_[static_cast<std::size_t>(tag)].bytes.load(std::memory_order_relaxed);
+    }
+
+    int64_t GetTaggedLiveBytes(MemoryTag tag) noexcept
+    {
+        const std::size_t index = static_cast<std::size_t>(tag);
+        int64_t bytes = RetiredBytes_[index].load(std::memory_order_relaxed);
+        for (const tagging::ThreadCounters& counters : CounterSlots_)
+        {
+            bytes += counters.liveBytes[index].load(std::memory_order_relaxed);
+        }
+        return bytes;
+    }
+
+    void CheckMemoryBudgets()
+    {
+        for (std::size_t i = 0; i < kMemoryTagCount; ++i)
+        {
+            Budget& budget = Budgets_[i];
+            const std::size_t limit = budget.bytes.load(std::memory_order_relaxed);
+            if (limit == 0)
+            {
+                budget.exceeded = false;
+                continue;
+            }
+
+            const MemoryTag tag = static_cast<MemoryTag>(i);
+            const int64_t live = GetTaggedLiveBytes(tag);
+            const bool exceeded = live > static_cast<int64_t>(limit);
+            if (exceeded == budget.exceeded)
+                continue;
+            budget.exceeded = exceeded;
+
+            // ֻԽԤʱÿ֡ˢ
+            if (!exceeded)
+            {
+                CBR_LOG(Memory, Info, "[memory] {} is back within its budget: {} of {} bytes.", ToString(tag), live, limit);
+                continue;
+            }
+
+            if (budget.action.load(std::memory_order_relaxed) == MemoryBudgetAction::Assert)
+            {
+                CBR_LOG(Memory, Error, "[memory] BUDGET EXCEEDED: {} uses {} bytes, budget {} bytes.", ToString(tag), live, limit);
+                assert(false && "Memory budget exceeded");
+            }
+            else
+            {
+                CBR_LOG(Memory, Warn, "[memory] BUDGET EXCEEDED: {} uses {} bytes, budget {} bytes.", ToString(tag), live, limit);
+            }
+        }
+    }
+
+    int ConfigureMemoryBudgets(std::string_view spec)
+    {
+        return Utility::ForEachSpecEntry(spec, [](std::string_view name, std::string_view value) {
+            MemoryBudgetAction action = MemoryBudgetAction::Warn;
+            if (!value.empty() && value.back() == '!')
+            {
+                action = MemoryBudgetAction::Assert;
+                value = Utility::Trim(value.substr(0, value.size() - 1));
+            }
+
+            const std::optional<std::size_t> bytes = ParseBytes(value);
+            if (!bytes)
+                return false;
+
+            for (std::size_t i = 0; i < kMemoryTagCount; ++i)
+            {
+                const MemoryTag tag = static_cast<MemoryTag>(i);
+                if (Utility::EqualsIgnoreCase(name, ToString(tag)))
+                {
+                    SetMemoryBudget(tag, *bytes, action);
+                    return true;
+                }
+            }
+            return false;
+        });
+    }
+
+    void LoadMemoryBudgets()
+    {
+        if (const std::string budgets = Utility::ReadEnvironmentVariable("CBR_MEMORY_BUDGETS"); !budgets.empty())
+        {
+            if (const int errors = ConfigureMemoryBudgets(budgets); errors != 0)
+                CBR_LOG(Memory, Warn, "[memory] CBR_MEMORY_BUDGETS: {} entries could not be parsed.", errors);
+        }
+    }
+} // namespace CBR::Engine::Memory
@@ -0,0 +1,273 @@
+#include "pch.h"
+#include "Engine/Memory/NoAllocScope.h"
+#include "Engine/Memory/NoAllocTracking.h"
+#include "Engine/Debug/StackTrace.h"
+#include "Engine/Debug/Logger.h"
+#include "Engine/Utility/Environment.h"
+
+namespace CBR::Engine::Memory
+{
+    namespace noalloc
+    {
+        constinit thread_local ThreadState t_state{};
+    }
+
+    namespace
+    {
+        constexpr std::size_t kMaxViolationSites = 256;   // 2
+        constexpr uint16_t kViolationStackDepth = 8;
+
+        struct ViolationSite
+        {
+            uint64_t key;           // 0 ʾղ
+            const char* file;
+            unsigned int line;
+            const char* region;
+            uint16_t depth;
+            void* frames[kViolationStackDepth];
+            uint64_t count;
+            uint64_t bytes;
+        };
+
+        // Υ汾Ͳö࣬Ժֻ
+        ViolationSite Sites_[kMaxViolationSites];
+        std::atomic_flag SitesLock_ = ATOMIC_FLAG_INIT;
+        uint64_t UnrecordedViolations_ = 0;
+
+        std::atomic<NoAllocMode> Mode_{ NoAllocMode::Off };
+        std::atomic<uint64_t> TotalViolations_{ 0 };
+        std::atomic<uint64_t> FrameViolations_{ 0 };
+        std::atomic<uint64_t> FrameViolationBytes_{ 0 };
+
+        // EndNoAllocFrame ̵ֻ߳
+        uint64_t FrameIndex_ = 0;
+        uint64_t LastAllocations_ = 0;
+        uint64_t LastBytes_ = 0;
+        std::mutex MetricsMutex_;
+        FrameAllocationMetrics LastMetrics_;
+
+        class SitesLockGuard
+        {
+        public:
+            SitesLockGuard() noexcept
+            {
+                while (SitesLock_.test_and_set(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            ~SitesLockGuard() { SitesLock_.clear(std::memory_order_release); }
+        };
+
+        uint64_t HashSite(const char* file, unsigned int line, void* const* frames, uint16_t depth) noexcept
+        {
+            uint64_t hash = 14695981039346656037ull;
+            auto mix = [&hash](uint64_t value) { hash = (hash ^ value) * 1099511628211ull; };
+            mix(reinterpret_cast<uintptr_t>(file));
+            mix(line);
+            for (uint16_t i = 0; i < depth; ++i)
+            {
+                mix(reinterpret_cast<uintptr_t>(frames[i]));
+            }
+            return hash | 1;
+        }
+
+        // λǲǵһγ
+        bool RecordSite(const char* file, unsigned int line, const char* region, void* const* frames, uint16_t depth, std::size_t size) noexcept
+        {
+            const uint64_t key = HashSite(file, line, frames, depth);
+            SitesLockGuard lock;
+            std::size_t slot = static_cast<std::size_t>(key) & (kMaxViolationSites - 1);
+            for (std::size_t probe = 0; probe < kMaxViolationSites; ++probe)
+            {
+                ViolationSite& site = Sites_[slot];
+                if (site.key == key)
+                {
+                    ++site.count;
+                    site.bytes += size;
+                    return false;
+                }
+                if (site.key == 0)
+                {
+                    site.key = key;
+                    site.file = file;
+                    site.line = line;
+                    site.region = region;
+                    site.depth = depth;
+                    std::copy(frames, frames + depth, site.frames);
+                    site.count = 1;
+                    site.bytes = size;
+                    return true;
+                }
+                slot = (slot + 1) & (kMaxViolationSites - 1);
+            }
+            ++UnrecordedViolations_;
+            return false;
+        }
+
+        const char* Location(const char* file)
+        {
+            return (file && *file) ? file : "<operator new>";
+        }
+    }
+
+    NoAllocScope::NoAllocScope(const char* name, bool active) noexcept
+        : previousName_(noalloc::t_state.region)
+        , active_(active && Mode_.load(std::memory_order_relaxed) != NoAllocMode::Off)
+    {
+        if (active_)
+        {
+            ++noalloc::t_state.depth;
+            noalloc::t_state.region = name;
+        }
+    }
+
+    NoAllocScope::~NoAllocScope()
+    {
+        if (active_)
+        {
+            --noalloc::t_state.depth;
+            noalloc::t_state.region = previousName_;
+        }
+    }
+
+    AllowAllocScope::AllowAllocScope() noexcept
+        : previousDepth_(noalloc::t_state.depth)
+    {
+        noalloc::t_state.depth = 0;
+    }
+
+    AllowAllocScope::~AllowAllocScope()
+    {
+        noalloc::t_state.depth = previousDepth_;
+    }
+
+    void SetNoAllocMode(NoAllocMode mode) noexcept
+    {
+        Mode_.store(mode, std::memory_order_relaxed);
+    }
+
+    NoAllocMode GetNoAllocMode() noexcept
+    {
+        return Mode_.load(std::memory_order_relaxed);
+    }
+
+    void noalloc::ReportViolation(std::size_t size, const char* file, unsigned int line) noexcept
+    {
+        // 汾־ŽҲ䣬ڼ䲻ټ
+        AllowAllocScope allow;
+
+        TotalViolations_.fetch_add(1, std::memory_order_relaxed);
+        FrameViolations_.fetch_add(1, std::memory_order_relaxed);
+        FrameViolationBytes_.fetch_add(size, std::memory_order_relaxed);
+
+        //  ReportViolation  operator new
+        void* frames[kViolationStackDepth];
+        const uint16_t depth = Debug::CaptureStack(frames, kViolationStackDepth, 2);
+        const char* region = t_state.region ? t_state.region : "";
+
+        if (RecordSite(file, line, region, frames, depth, size))
+        {
+            try
+            {
+                std::string caller;
+                for (uint16_t i = 0; i < depth && i < 3; ++i)
+                {
+                    caller += (i == 0 ? "" : " <- ") + Debug::DescribeFrame(frames[i]);
+                }
+                CBR_LOG(Memory, Warn, "[memory] NO-ALLOC: {} bytes allocated inside '{}' at {}:{}, {}.", size, region, Location(file), line, caller);
+            }
+            catch (...)
+            {
+            }
+        }
+
+        if (Mode_.load(std::memory_order_relaxed) == NoAllocMode::Strict)
+        {
+            assert(false && "Heap allocation inside a NoAllocScope");
+        }
+    }
+
+    void LoadNoAllocMode()
+    {
+        const std::string mode = Utility::ReadEnvironmentVariable("CBR_NOALLOC");
+        if (mode == "1" || mode == "report")
+            SetNoAllocMode(NoAllocMode::Report);
+        else if (mode == "2" || mode == "strict")
+            SetNoAllocMode(NoAllocMode::Strict);
+    }
+
+    void EndNoAllocFrame()
+    {
+        const noalloc::ThreadState& state = noalloc::t_state;
+
+        FrameAllocationMetrics metrics;
+        metrics.frame = FrameIndex_++;
+        metrics.allocations = state.allocations - LastAllocations_;
+        metrics.bytes = state.bytes - LastBytes_;
+        metrics.violations = FrameViolations_.exchange(0, std::memory_order_relaxed);
+        metrics.violationBytes = FrameViolationBytes_.exchange(0, std::memory_order_relaxed);
+        LastAllocations_ = state.allocations;
+        LastBytes_ = state.bytes;
+        {
+            std::lock_guard<std::mutex> lk(MetricsMutex_);
+            LastMetrics_ = metrics;
+        }
+
+        if (metrics.violations != 0)
+        {
+            CBR_LOG_LIMITED(Memory, Warn, 1, "[memory] Frame {}: {} allocations ({} bytes) inside no-alloc regions.",
+                metrics.frame, metrics.violations, metrics.violationBytes);
+        }
+    }
+
+    FrameAllocationMetrics GetLastFrameAllocationMetrics() noexcept
+    {
+        std::lock_guard<std::mutex> lk(MetricsMutex_);
+        return LastMetrics_;
+    }
+
+    uint64_t GetNoAllocViolationCount() noexcept
+    {
+        return TotalViolations_.load(std::memory_order_relaxed);
+    }
+
+    bool WriteNoAllocReport(const char* path)
+    {
+        if (!path || !*path)
+            return false;
+
+        // ȷãбʱܷڴ
+        std::vector<ViolationSite> sites;
+        sites.reserve(kMaxViolationSites);
+        uint64_t unrecorded = 0;
+        {
+            SitesLockGuard lock;
+            for (const ViolationSite& site : Sites_)
+            {
+                if (site.key != 0)
+                    sites.push_back(site);
+            }
+            unrecorded = UnrecordedViolations_;
+        }
+        std::sort(sites.begin(), sites.end(), [](const ViolationSite& a, const ViolationSite& b) { return a.count > b.count; });
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file)
+            return false;
+
+        file << "# CBR no-alloc report\n";
+        file << "# violations " << GetNoAllocViolationCount() << ", sites " << sites.size() << ", unrecorded " << unrecorded << "\n";
+        file << "# count bytes region location\n\n";
+        for (const ViolationSite& site : sites)
+        {
+            file << site.count << ' ' << site.bytes << ' ' << site.region << ' ' << Location(site.file) << ':' << site.line << '\n';
+            for (uint16_t i = 0; i < site.depth; ++i)
+            {
+                file << "    at " << Debug::DescribeFrame(site.frames[i]) << '\n';
+            }
+            file << '\n';
+        }
+        return static_cast<bool>(file);
+    }
+} // namespace CBR::Engine::Memory
@@ -0,0 +1,422 @@
+#include "pch.h"
+#include "Engine/Memory/PoolAllocator.h"
+
+// ķ·ȫ operator new ĵײ㣬ļܵ operator new
+// Ҳ̬Ĺ˳ȫ״̬ǳʼ
+
+namespace CBR::Engine::Memory
+{
+    namespace
+    {
+        // chunk ͷ ChunkHeaderһ￪ʼǰĿռ㹻й©ǰһ¼
+        constexpr std::size_t kChunkHeaderSize = 128;
+        // ǰͷС chunk ͷһ
+        constexpr std::size_t kLargeHeaderSize = 128;
+        constexpr uint32_t kLargeMagic = 0xCB7A12E5u;
+
+#if defined(_WIN64) || defined(__x86_64__) || defined(__aarch64__)
+        constexpr std::size_t kRegionSize = std::size_t{ 64 } << 30; // ַֻռڴ
+#else
+        constexpr std::size_t kRegionSize = std::size_t{ 256 } << 20;
+#endif
+
+        struct ChunkHeader
+        {
+            uint32_t sizeClass;
+        };
+
+        struct LargeHeader
+        {
+            std::size_t mappedBytes;
+            std::size_t size;
+            uint32_t magic;
+        };
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        constexpr std::size_t ClassSizeOf(std::size_t sizeClass) noexcept
+        {
+            if (sizeClass < 8)
+                return (sizeClass + 1) * 16;
+            const std::size_t group = (sizeClass - 8) / 4;
+            const std::size_t step = (sizeClass - 8) % 4;
+            return (std::size_t{ 128 } << group) + (step + 1) * (std::size_t{ 32 } << group);
+        }
+
+        constexpr std::size_t SizeClassOf(std::size_t size) noexcept
+        {
+            if (size <= 128)
+                return size == 0 ? 0 : (size - 1) / 16;
+            const std::size_t s = size - 1;
+            const std::size_t bits = static_cast<std::size_t>(std::bit_width(s));
+            return 8 + (bits - 8) * 4 + ((s >> (bits - 3)) & 3);
+        }
+
+        static_assert(ClassSizeOf(kPoolSizeClassCount - 1) == kPoolMaxSmallSize);
+        static_assert(SizeClassOf(kPoolMaxSmallSize) == kPoolSizeClassCount - 1);
+        static_assert(SizeClassOf(129) == 8 && SizeClassOf(160) == 8 && SizeClassOf(161) == 9 && SizeClassOf(257) == 12);
+
+        // ̻߳Ĳֿ֮һΰٿ飺Сᣬٰ
+        constexpr uint32_t BatchSizeOf(std::size_t sizeClass) noexcept
+        {
+            return static_cast<uint32_t>(std::clamp<std::size_t>(8192 / ClassSizeOf(sizeClass), 2, 128));
+        }
+
+        class SpinLock
+        {
+        public:
+            void lock() noexcept
+            {
+                while (flag_.test_and_set(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+            }
+            void unlock() noexcept { flag_.clear(std::memory_order_release); }
+
+        private:
+            std::atomic_flag flag_ = ATOMIC_FLAG_INIT;
+        };
+
+        struct alignas(64) CentralList
+        {
+            SpinLock lock;
+            FreeBlock* head = nullptr;
+            std::size_t count = 0;
+        };
+
+        CentralList Central_[kPoolSizeClassCount];
+
+        // ĵַռ䣺[RegionBase_, RegionBase_ + kRegionSize)chunk ǰ
+        std::atomic<unsigned char*> RegionBase_{ nullptr };
+        std::size_t RegionUsed_ = 0;
+        SpinLock RegionLock_;
+
+        std::atomic<uint64_t> ChunkBytes_{ 0 };
+        std::atomic<uint64_t> LargeBlocks_{ 0 };
+        std::atomic<uint64_t> LargeBytes_{ 0 };
+
+        struct ThreadCacheList
+        {
+            FreeBlock* head;
+            uint32_t count;
+        };
+
+        // ƽ̵ͣ߳κν׶ζܷʣReleaser Ժ retired Ϊ true֮ͷֱӻĲֿ
+        struct ThreadCache
+        {
+            ThreadCacheList lists[kPoolSizeClassCount];
+            bool registered;
+            bool retired;
+        };
+
+        thread_local ThreadCache t_cache{};
+
+        struct ThreadCacheReleaser
+        {
+            bool active = false;
+
+            ~ThreadCacheReleaser()
+            {
+                if (!active)
+                    return;
+                PoolFlushThreadCache();
+                t_cache.retired = true;
+            }
+        };
+
+        thread_local ThreadCacheReleaser t_releaser;
+
+        unsigned char* ReserveRegion() noexcept
+        {
+#ifdef _WIN32
+            // VirtualAlloc ĵַ 64KB 룬 chunk ĴС
+            static_assert(kPoolChunkSize == 64 * 1024);
+            return static_cast<unsigned char*>(::VirtualAlloc(nullptr, kRegionSize, MEM_RESERVE, PAGE_NOACCESS));
+#else
+            // ౣһ chunk뵽 chunk СMAP_NORESERVE ֻõҳռڴ
+            void* p = ::mmap(nullptr, kRegionSize + kPoolChunkSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (p == MAP_FAILED)
+                return nullptr;
+            const uintptr_t aligned = (reinterpret_cast<uintptr_t>(p) + kPoolChunkSize - 1) & ~(uintptr_t{ kPoolChunkSize } - 1);
+            return reinterpret_cast<unsigned char*>(aligned);
+#endif
+        }
+
+        bool InRegion(const void* p) noexcept
+        {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(RegionBase_.load(std::memory_order_acquire));
+            return base != 0 && reinterpret_cast<uintptr_t>(p) - base < kRegionSize;
+        }
+
+        ChunkHeader* ChunkOf(const void* p) noexcept
+        {
+            return reinterpret_cast<ChunkHeader*>(reinterpret_cast<uintptr_t>(p) & ~(uintptr_t{ kPoolChunkSize } - 1));
+        }
+
+        // ʧܣַռύʧܣ nullptr÷˻ص·
+        unsigned char* AllocateChunk() noexcept
+        {
+            std::lock_guard<SpinLock> lk(RegionLock_);
+            unsigned char* base = RegionBase_.load(std::memory_order_relaxed);
+            if (!base)
+            {
+                base = ReserveRegion();
+                if (!base)
+                    return nullptr;
+                RegionBase_.store(base, std::memory_order_release);
+            }
+            if (RegionUsed_ + kPoolChunkSize > kRegionSize)
+                return nullptr;
+
+            unsigned char* chunk = base + RegionUsed_;
+#ifdef _WIN32
+            if (!::VirtualAlloc(chunk, kPoolChunkSize, MEM_COMMIT, PAGE_READWRITE))
+                return nullptr;
+#endif
+            RegionUsed_ += kPoolChunkSize;
+            ChunkBytes_.fetch_add(kPoolChunkSize, std::memory_order_relaxed);
+            return chunk;
+        }
+
+        void* AllocateLarge(std::size_t size) noexcept
+        {
+            if (size > std::numeric_limits<std::size_t>::max() - kLargeHeaderSize - kPoolChunkSize)
+                return nullptr;
+            const std::size_t mapped = (size + kLargeHeaderSize + 4095) & ~std::size_t{ 4095 };
+#ifdef _WIN32
+            void* memory = ::VirtualAlloc(nullptr, mapped, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+            if (!memory)
+                return nullptr;
+#else
+            void* memory = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED)
+                return nullptr;
+#endif
+            LargeHeader* header = static_cast<LargeHeader*>(memory);
+            header->mappedBytes = mapped;
+            header->size = size;
+            header->magic = kLargeMagic;
+            LargeBlocks_.fetch_add(1, std::memory_order_relaxed);
+            LargeBytes_.fetch_add(mapped, std::memory_order_relaxed);
+            return static_cast<unsigned char*>(memory) + kLargeHeaderSize;
+        }
+
+        void FreeLarge(void* p) noexcept
+        {
+            LargeHeader* header = reinterpret_cast<LargeHeader*>(static_cast<unsigned char*>(p) - kLargeHeaderSize);
+            assert(header->magic == kLargeMagic && "PoolFree: pointer was not allocated by the pool");
+            const std::size_t mapped = header->mappedBytes;
+            LargeBlocks_.fetch_sub(1, std::memory_order_relaxed);
+            LargeBytes_.fetch_sub(mapped, std::memory_order_relaxed);
+#ifdef _WIN32
+            ::VirtualFree(header, 0, MEM_RELEASE);
+#else
+            ::munmap(header, mapped);
+#endif
+        }
+
+        // Ĳֿȡ count 鴮ʱµ chunkȡĿ
+        uint32_t FetchFromCentral(std::size_t sizeClass, uint32_t count, FreeBlock*& head) noexcept
+        {
+            CentralList& central = Central_[sizeClass];
+            {
+                std::lock_guard<SpinLock> lk(central.lock);
+                if (central.head)
+                {
+                    FreeBlock* first = central.head;
+                    FreeBlock* last = first;
+                    uint32_t taken = 1;
+                    while (taken < count && last->next)
+                    {
+                        last = last->next;
+                        ++taken;
+                    }
+                    central.head = last->next;
+                    central.count -= taken;
+                    last->next = nullptr;
+                    head = first;
+                    return taken;
+                }
+            }
+
+            unsigned char* chunk = AllocateChunk();
+            if (!chunk)
+                return 0;
+            reinterpret_cast<ChunkHeader*>(chunk)->sizeClass = static_cast<uint32_t>(sizeClass);
+
+            //  chunk гɿ飬ǰ count ÷ʣµķŽĲֿ
+            const std::size_t blockSize = ClassSizeOf(sizeClass);
+            const std::size_t blocks = (kPoolChunkSize - kChunkHeaderSize) / blockSize;
+            FreeBlock* first = nullptr;
+            for (std::size_t i = blocks; i-- > 0;)
+            {
+                FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + kChunkHeaderSize + i * blockSize);
+                block->next = first;
+                first = block;
+            }
+
+            FreeBlock* last = first;
+            uint32_t taken = 1;
+            while (taken < count && last->next)
+            {
+                last = last->next;
+                ++taken;
+            }
+            FreeBlock* rest = last->next;
+            last->next = nullptr;
+            head = first;
+
+            if (rest)
+            {
+                FreeBlock* restTail = rest;
+                while (restTail->next)
+                {
+                    restTail = restTail->next;
+                }
+                std::lock_guard<SpinLock> lk(central.lock);
+                restTail->next = central.head;
+                central.head = rest;
+                central.count += blocks - taken;
+            }
+            return taken;
+        }
+
+        void ReturnToCentral(std::size_t sizeClass, FreeBlock* first, FreeBlock* last, uint32_t count) noexcept
+        {
+            CentralList& central = Central_[sizeClass];
+            std::lock_guard<SpinLock> lk(central.lock);
+            last->next = central.head;
+            central.head = first;
+            central.count += count;
+        }
+
+        void* RefillAndAllocate(std::size_t sizeClass) noexcept
+        {
+            // һߵ·ʱŹ t_releaserǼ߳˳ʱ
+            if (!t_cache.registered && !t_cache.retired)
+            {
+                t_cache.registered = true;
+                t_releaser.active = true;
+            }
+
+            FreeBlock* head = nullptr;
+            const uint32_t count = FetchFromCentral(sizeClass, t_cache.retired ? 1 : BatchSizeOf(sizeClass), head);
+            if (count == 0)
+                return nullptr;
+
+            if (count > 1)
+            {
+                ThreadCacheList& list = t_cache.lists[sizeClass];
+                list.head = head->next;
+                list.count = count - 1;
+            }
+            return head;
+        }
+    }
+
+    void* PoolAllocate(std::size_t size) noexcept
+    {
+        if (size > kPoolMaxSmallSize)
+            return AllocateLarge(size);
+
+        const std::size_t sizeClass = SizeClassOf(size);
+        ThreadCacheList& list = t_cache.lists[sizeClass];
+        if (FreeBlock* block = list.head)
+        {
+            list.head = block->next;
+            --list.count;
+            return block;
+        }
+
+        if (void* block = RefillAndAllocate(sizeClass))
+            return block;
+        // ַռʱСҲֱϵͳҪ
+        return AllocateLarge(size);
+    }
+
+    void PoolFree(void* p) noexcept
+    {
+        if (!p)
+            return;
+        if (!InRegion(p))
+        {
+            FreeLarge(p);
+            return;
+        }
+
+        const std::size_t sizeClass = ChunkOf(p)->sizeClass;
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        if (t_cache.retired)
+        {
+            block->next = nullptr;
+            ReturnToCentral(sizeClass, block, block, 1);
+            return;
+        }
+
+        ThreadCacheList& list = t_cache.lists[sizeClass];
+        block->next = list.head;
+        list.head = block;
+
+        // 泬ʱһķ/ͷڻأÿζĲֿ
+        const uint32_t batch = BatchSizeOf(sizeClass);
+        if (++list.count > batch * 2)
+        {
+            FreeBlock* last = list.head;
+            for (uint32_t i = 1; i < batch; ++i)
+            {
+                last = last->next;
+            }
+            FreeBlock* first = list.head;
+            list.head = last->next;
+            list.count -= batch;
+            ReturnToCentral(sizeClass, first, last, batch);
+        }
+    }
+
+    std::size_t PoolUsableSize(const void* p) noexcept
+    {
+        if (!p)
+            return 0;
+        if (!InRegion(p))
+            return reinterpret_cast<const LargeHeader*>(static_cast<const unsigned char*>(p) - kLargeHeaderSize)->size;
+        return ClassSizeOf(ChunkOf(p)->sizeClass);
+    }
+
+    void PoolFlushThreadCache() noexcept
+    {
+        for (std::size_t sizeClass = 0; sizeClass < kPoolSizeClassCount; ++sizeClass)
+        {
+            ThreadCacheList& list = t_cache.lists[sizeClass];
+            if (!list.head)
+                continue;
+
+            FreeBlock* last = list.head;
+            while (last->next)
+            {
+                last = last->next;
+            }
+            ReturnToCentral(sizeClass, list.head, last, list.count);
+            list.head = nullptr;
+            list.count = 0;
+        }
+    }
+
+    PoolStats GetPoolStats() noexcept
+    {
+        PoolStats stats;
+        stats.reservedBytes = RegionBase_.load(std::memory_order_relaxed) ? kRegionSize : 0;
+        stats.chunkBytes = ChunkBytes_.load(std::memory_order_relaxed);
+        stats.largeBlocks = LargeBlocks_.load(std::memory_order_relaxed);
+        stats.largeBytes = LargeBytes_.load(std::memory_order_relaxed);
+        for (CentralList& central : Central_)
+        {
+            std::lock_guard<SpinLock> lk(central.lock);
+            stats.centralBlocks += central.count;
+        }
+        return stats;
+    }
+} // namespace CBR::Engine::Memory
@@ -0,0 +1,382 @@
+#include "pch.h"
+#include "Engine/Debug/Profiler.h"
+#include "Engine/Utility/Clock.h"
+
+namespace CBR::Engine::Debug
+{
+    namespace
+    {
+        struct ProfileEvent
+        {
+            const char* name;
+            uint64_t begin;
+            uint64_t end;
+            uint32_t threadId;
+            uint32_t depth;
+        };
+
+        constexpr int32_t kNoNode = -1;         //  zone  parent
+        constexpr int32_t kUntracked = -2;      // ڵ˻̫ֻ¼
+        constexpr std::size_t kNodeIndexSize = Profiler::kMaxNodes * 2;
+
+        struct ProfileNode
+        {
+            const char* name;
+            int32_t parent;
+            uint32_t depth;
+            uint64_t frameTicks;    // ̶ֻ߳дEndFrame ʱ
+            uint64_t frameCalls;
+        };
+
+        struct FrameMark
+        {
+            uint64_t frame;
+            uint64_t begin;
+            uint64_t end;
+        };
+
+        std::atomic<uint32_t> NextThreadId_{ 1 };
+        std::atomic<uint64_t> StartTick_{ 0 };
+
+        // ֡ǣֻ߳д
+        FrameMark FrameMarks_[Profiler::kMaxFrames];
+        std::atomic<uint64_t> FrameHead_{ 0 };
+        uint64_t CurrentFrame_ = 0;
+        uint64_t CurrentFrameBegin_ = 0;
+        bool FrameOpen_ = false;
+
+        // EndFrame ʱ̵߳ĽڵƳ̶߳ȡʱ
+        std::mutex SummaryMutex_;
+        uint64_t LastFrameTicks_[Profiler::kMaxNodes];
+        uint64_t LastFrameCalls_[Profiler::kMaxNodes];
+        uint64_t TotalTicks_[Profiler::kMaxNodes];
+        uint64_t TotalCalls_[Profiler::kMaxNodes];
+        uint64_t SummarizedFrames_ = 0;
+
+        uint32_t NodeSlot(const char* name, int32_t parent) noexcept
+        {
+            uint64_t hash = reinterpret_cast<uintptr_t>(name) * 0x9E3779B97F4A7C15ull;
+            hash ^= static_cast<uint64_t>(static_cast<uint32_t>(parent)) * 0xC2B2AE3D27D4EB4Full;
+            return static_cast<uint32_t>(hash >> 32) & (kNodeIndexSize - 1);
+        }
+
+        void WriteJsonString(std::ostream& out, const char* text)
+        {
+            out << '"';
+            for (const char* c = text ? text : ""; *c; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    out << '\\' << *c;
+                else if (static_cast<unsigned char>(*c) < 0x20)
+                    out << ' ';
+                else
+                    out << *c;
+            }
+            out << '"';
+        }
+    }
+
+    struct Profiler::ThreadProfile
+    {
+        ThreadProfile* next = nullptr;
+        std::atomic<bool> inUse{ false };
+        uint32_t threadId = 0;
+
+        ProfileEvent* events = nullptr;
+        std::atomic<uint64_t> head{ 0 };
+
+        // ò㼶ڵֻȶ nodeCountacquire
+        ProfileNode nodes[kMaxNodes];
+        std::atomic<uint32_t> nodeCount{ 0 };
+        int16_t nodeIndex[kNodeIndexSize];  // 0 Ϊգ ڵ±+1
+        int32_t stack[kMaxDepth];
+        uint32_t depth = 0;
+
+        int32_t FindOrAddNode(const char* name, int32_t parent) noexcept
+        {
+            if (parent == kUntracked)
+                return kUntracked;
+
+            uint32_t slot = NodeSlot(name, parent);
+            for (std::size_t probe = 0; probe < kNodeIndexSize; ++probe)
+            {
+                const int16_t entry = nodeIndex[slot];
+                if (entry == 0)
+                {
+                    const uint32_t count = nodeCount.load(std::memory_order_relaxed);
+                    if (count >= kMaxNodes)
+                        return kUntracked;
+                    nodes[count] = ProfileNode{ name, parent, depth, 0, 0 };
+                    nodeIndex[slot] = static_cast<int16_t>(count + 1);
+                    nodeCount.store(count + 1, std::memory_order_release);
+                    return static_cast<int32_t>(count);
+                }
+                const ProfileNode& node = nodes[entry - 1];
+                if (node.name == name && node.parent == parent)
+                    return entry - 1;
+                slot = (slot + 1) & (kNodeIndexSize - 1);
+            }
+            return kUntracked;
+        }
+    };
+
+    Profiler::ThreadProfile* Profiler::AcquireThreadProfile() noexcept
+    {
+        // ߳˳ʱѻȥһ̸߳
+        struct ProfileReleaser
+        {
+            ThreadProfile* profile = nullptr;
+            ~ProfileReleaser()
+            {
+                if (profile)
+                    profile->inUse.store(false, std::memory_order_release);
+            }
+        };
+        static thread_local ProfileReleaser t_releaser;
+
+        ThreadProfile* profile = nullptr;
+        for (ThreadProfile* p = s_profiles.load(std::memory_order_acquire); p; p = p->next)
+        {
+            bool expected = false;
+            if (p->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            {
+                profile = p;
+                break;
+            }
+        }
+
+        if (!profile)
+        {
+            //  malloc  newLeakTracker::Alloc Ҳ zone operator new ݹ
+            void* memory = std::malloc(sizeof(ThreadProfile) + sizeof(ProfileEvent) * kEventsPerThread);
+            if (!memory)
+                return nullptr;
+
+            profile = ::new (memory) ThreadProfile();
+            profile->events = reinterpret_cast<ProfileEvent*>(profile + 1);
+            std::memset(profile->nodeIndex, 0, sizeof(profile->nodeIndex));
+            profile->inUse.store(true, std::memory_order_relaxed);
+
+            ThreadProfile* head = s_profiles.load(std::memory_order_relaxed);
+            do
+            {
+                profile->next = head;
+            } while (!s_profiles.compare_exchange_weak(head, profile, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        profile->threadId = NextThreadId_.fetch_add(1, std::memory_order_relaxed);
+        profile->depth = 0;
+        t_releaser.profile = profile;
+        t_profile = profile;
+        return profile;
+    }
+
+    void ProfileScope::Begin(const char* name) noexcept
+    {
+        Profiler::ThreadProfile* profile = Profiler::t_profile ? Profiler::t_profile : Profiler::AcquireThreadProfile();
+        if (!profile)
+            return;
+
+        profile_ = profile;
+        name_ = name;
+        if (profile->depth < Profiler::kMaxDepth)
+        {
+            const int32_t parent = profile->depth == 0 ? kNoNode : profile->stack[profile->depth - 1];
+            profile->stack[profile->depth] = profile->FindOrAddNode(name, parent);
+        }
+        ++profile->depth;
+        begin_ = Utility::Clock::Now();
+    }
+
+    void ProfileScope::End() noexcept
+    {
+        const uint64_t end = Utility::Clock::Now();
+        Profiler::ThreadProfile* profile = profile_;
+        const uint32_t depth = --profile->depth;
+
+        const uint64_t index = profile->head.load(std::memory_order_relaxed);
+        profile->events[index & (Profiler::kEventsPerThread - 1)] = ProfileEvent{ name_, begin_, end, profile->threadId, depth };
+        profile->head.store(index + 1, std::memory_order_release);
+
+        if (depth < Profiler::kMaxDepth)
+        {
+            const int32_t node = profile->stack[depth];
+            if (node >= 0)
+            {
+                profile->nodes[node].frameTicks += end - begin_;
+                ++profile->nodes[node].frameCalls;
+            }
+        }
+    }
+
+    void Profiler::Start()
+    {
+        {
+            std::lock_guard<std::mutex> lk(SummaryMutex_);
+            std::memset(LastFrameTicks_, 0, sizeof(LastFrameTicks_));
+            std::memset(LastFrameCalls_, 0, sizeof(LastFrameCalls_));
+            std::memset(TotalTicks_, 0, sizeof(TotalTicks_));
+            std::memset(TotalCalls_, 0, sizeof(TotalCalls_));
+            SummarizedFrames_ = 0;
+        }
+        StartTick_.store(Utility::Clock::Now(), std::memory_order_relaxed);
+        s_enabled.store(true, std::memory_order_release);
+    }
+
+    void Profiler::Stop()
+    {
+        s_enabled.store(false, std::memory_order_release);
+    }
+
+    void Profiler::BeginFrame(uint64_t frameIndex) noexcept
+    {
+        FrameOpen_ = IsEnabled();
+        if (!FrameOpen_)
+            return;
+        CurrentFrame_ = frameIndex;
+        CurrentFrameBegin_ = Utility::Clock::Now();
+    }
+
+    void Profiler::EndFrame() noexcept
+    {
+        if (!FrameOpen_)
+            return;
+        FrameOpen_ = false;
+
+        const uint64_t index = FrameHead_.load(std::memory_order_relaxed);
+        FrameMarks_[index % kMaxFrames] = FrameMark{ CurrentFrame_, CurrentFrameBegin_, Utility::Clock::Now() };
+        FrameHead_.store(index + 1, std::memory_order_release);
+
+        ThreadProfile* profile = t_profile;
+        if (!profile)
+            return;
+        s_mainThread.store(profile, std::memory_order_release);
+
+        // һ֡Ĳ㼶ʱ
+        const uint32_t count = profile->nodeCount.load(std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lk(SummaryMutex_);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            ProfileNode& node = profile->nodes[i];
+            LastFrameTicks_[i] = node.frameTicks;
+            LastFrameCalls_[i] = node.frameCalls;
+            TotalTicks_[i] += node.frameTicks;
+            TotalCalls_[i] += node.frameCalls;
+            node.frameTicks = 0;
+            node.frameCalls = 0;
+        }
+        ++SummarizedFrames_;
+    }
+
+    // ò㼶Уֵܽڵ㰴һγֵ˳
+    std::vector<ProfileNodeSummary> Profiler::BuildSummary(const uint64_t* ticks, const uint64_t* calls, double frames)
+    {
+        std::vector<ProfileNodeSummary> summary;
+        const ThreadProfile* profile = s_mainThread.load(std::memory_order_acquire);
+        if (!profile || frames <= 0.0)
+            return summary;
+
+        const uint32_t count = profile->nodeCount.load(std::memory_order_acquire);
+        std::vector<std::vector<uint32_t>> children(count + 1);     // children[count] 
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const int32_t parent = profile->nodes[i].parent;
+            children[parent < 0 ? count : static_cast<uint32_t>(parent)].push_back(i);
+        }
+
+        std::vector<uint32_t> stack(children[count].rbegin(), children[count].rend());
+        summary.reserve(count);
+        while (!stack.empty())
+        {
+            const uint32_t i = stack.back();
+            stack.pop_back();
+            if (calls[i] != 0)
+            {
+                ProfileNodeSummary node;
+                node.name = profile->nodes[i].name;
+                node.depth = profile->nodes[i].depth;
+                node.milliseconds = static_cast<double>(Utility::Clock::ToNanoseconds(ticks[i])) * 1e-6 / frames;
+                node.calls = static_cast<double>(calls[i]) / frames;
+                summary.push_back(node);
+            }
+            stack.insert(stack.end(), children[i].rbegin(), children[i].rend());
+        }
+        return summary;
+    }
+
+    std::vector<ProfileNodeSummary> Profiler::GetLastFrameSummary()
+    {
+        std::lock_guard<std::mutex> lk(SummaryMutex_);
+        return BuildSummary(LastFrameTicks_, LastFrameCalls_, SummarizedFrames_ ? 1.0 : 0.0);
+    }
+
+    std::vector<ProfileNodeSummary> Profiler::GetAverageFrameSummary()
+    {
+        std::lock_guard<std::mutex> lk(SummaryMutex_);
+        return BuildSummary(TotalTicks_, TotalCalls_, static_cast<double>(SummarizedFrames_));
+    }
+
+    bool Profiler::WriteChromeTrace(const char* path)
+    {
+        if (!path || !*path)
+            return false;
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file)
+            return false;
+
+        const uint64_t start = StartTick_.load(std::memory_order_relaxed);
+        auto micros = [start](uint64_t ticks) { return static_cast<double>(Utility::Clock::ToNanoseconds(ticks - start)) * 1e-3; };
+        auto duration = [](uint64_t begin, uint64_t end) { return static_cast<double>(Utility::Clock::ToNanoseconds(end - begin)) * 1e-3; };
+
+        file << std::fixed << std::setprecision(3);
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        auto separator = [&file, &first]() -> std::ostream& { file << (first ? "" : ",\n"); first = false; return file; };
+
+        const ThreadProfile* mainThread = s_mainThread.load(std::memory_order_acquire);
+        const uint32_t mainThreadId = mainThread ? mainThread->threadId : 0;
+        for (const ThreadProfile* profile = s_profiles.load(std::memory_order_acquire); profile; profile = profile->next)
+        {
+            const uint64_t head = profile->head.load(std::memory_order_acquire);
+            const uint64_t available = head < kEventsPerThread ? head : kEventsPerThread;
+            std::vector<uint32_t> threadIds;
+            for (uint64_t i = head - available; i < head; ++i)
+            {
+                const ProfileEvent event = profile->events[i & (kEventsPerThread - 1)];
+                // д߳̿Ѿƻλ
+                if (profile->head.load(std::memory_order_acquire) - i > kEventsPerThread)
+                    continue;
+                if (event.begin < start || event.end < event.begin)
+                    continue;
+                if (threadIds.empty() || threadIds.back() != event.threadId)
+                    threadIds.push_back(event.threadId);
+                separator() << "{\"ph\":\"X\",\"cat\":\"cpu\",\"pid\":1,\"tid\":" << event.threadId << ",\"ts\":" << micros(event.begin)
+                    << ",\"dur\":" << duration(event.begin, event.end) << ",\"name\":";
+                WriteJsonString(file, event.name);
+                file << '}';
+            }
+            std::sort(threadIds.begin(), threadIds.end());
+            threadIds.erase(std::unique(threadIds.begin(), threadIds.end()), threadIds.end());
+            for (const uint32_t threadId : threadIds)
+            {
+                separator() << "{\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId << ",\"name\":\"thread_name\",\"args\":{\"name\":\""
+                    << (threadId == mainThreadId ? "Main" : "Thread ") << (threadId == mainThreadId ? "" : std::to_string(threadId)) << "\"}}";
+            }
+        }
+
+        // ֡ǻ߳ϣzone Ƕ
+        const uint64_t frames = FrameHead_.load(std::memory_order_acquire);
+        for (uint64_t i = frames > kMaxFrames ? frames - kMaxFrames : 0; i < frames; ++i)
+        {
+            const FrameMark& mark = FrameMarks_[i % kMaxFrames];
+            if (mark.begin < start)
+                continue;
+            separator() << "{\"ph\":\"X\",\"cat\":\"frame\",\"pid\":1,\"tid\":" << mainThreadId << ",\"ts\":" << micros(mark.begin)
+                << ",\"dur\":" << duration(mark.begin, mark.end) << ",\"name\":\"Frame\",\"args\":{\"frame\":" << mark.frame << "}}";
+        }
+
+        file << "\n]}\n";
+        return static_cast<bool>(file);
+    }
+}
@@ -1,11 +1,14 @@
 #include "pch.h"
 #include "Engine/Graphics/Renderer.h"
 #include "Engine/Graphics/D3D11Renderer.h"
+#include "Engine/Memory/MemoryTag.h"
+#include "Engine/Debug/Profiler.h"
 
 namespace CBR::Engine::Graphics
 {
 	bool Renderer::Initialize()
 	{
+		Memory::MemoryTagScope memoryTag(Memory::MemoryTag::Renderer);
 		/// TODO: δRenderSettingѡ1112
 		instance_ = std::make_unique<D3D11Renderer>();
 		return instance_->Initialize();
@@ -13,21 +16,28 @@ namespace CBR::Engine::Graphics
 
 	void Renderer::Shutdown()
 	{
+		Memory::MemoryTagScope memoryTag(Memory::MemoryTag::Renderer);
 		instance_.reset();
 	}
 
 	void Renderer::BeginFrame()
 	{
+		Memory::MemoryTagScope memoryTag(Memory::MemoryTag::Renderer);
+		CBR_PROFILE_SCOPE("Renderer::BeginFrame");
 		instance_->BeginFrame();
 	}
 
 	void Renderer::EndFrame()
 	{
+		Memory::MemoryTagScope memoryTag(Memory::MemoryTag::Renderer);
+		CBR_PROFILE_SCOPE("Renderer::EndFrame");
 		instance_->EndFrame();
 	}
 
-	void Renderer::Render()
+	void Renderer::Render(float alpha)
 	{
-		instance_->Render();
+		Memory::MemoryTagScope memoryTag(Memory::MemoryTag::Renderer);
+		CBR_PROFILE_SCOPE("Renderer::Render");
+		instance_->Render(alpha);
 	}
 }
\ No newline at end of file
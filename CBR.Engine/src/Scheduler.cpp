@@ -0,0 +1,343 @@
+#include "pch.h"
+#include "Engine/Utility/Scheduler.h"
+
+namespace CBR::Engine::Utility
+{
+	namespace
+	{
+		constexpr uint64_t kNanosecondsPerTick = 1000000;
+
+		uint64_t SecondsToTicks(double seconds)
+		{
+			//  1 tickڻصһ Advance ִ
+			if (!(seconds > 0.0))
+				return 1;
+			// ȥһ0.007 / 0.001 ĸ 1 tick
+			const double ticks = std::ceil(seconds / Scheduler::kResolutionSeconds - 1e-6);
+			return ticks >= 1.8e19 ? UINT64_MAX / 2 : (ticks < 1.0 ? 1 : static_cast<uint64_t>(ticks));
+		}
+
+		uint64_t SecondsToNanoseconds(double seconds)
+		{
+			return seconds > 0.0 ? static_cast<uint64_t>(seconds * 1e9 + 0.5) : 0;
+		}
+	}
+
+	Scheduler::Scheduler()
+	{
+		for (Wheel& wheel : wheels_)
+		{
+			std::fill(std::begin(wheel.heads), std::end(wheel.heads), kNil);
+		}
+		expired_.reserve(256);
+	}
+
+	Scheduler::~Scheduler() = default;
+
+	TimerHandle Scheduler::Schedule(double delaySeconds, Callback callback, TimeDomain domain)
+	{
+		return Add(SecondsToTicks(delaySeconds), 0, std::move(callback), domain);
+	}
+
+	TimerHandle Scheduler::ScheduleRepeating(double intervalSeconds, Callback callback, TimeDomain domain)
+	{
+		const uint64_t interval = SecondsToTicks(intervalSeconds);
+		return Add(interval, interval, std::move(callback), domain);
+	}
+
+	TimerHandle Scheduler::Add(uint64_t delayTicks, uint64_t intervalTicks, Callback&& callback, TimeDomain domain)
+	{
+		assert(callback && "Scheduler: empty callback");
+		const uint32_t index = AllocateNode();
+		TimerNode& node = Node(index);
+		node.callback = std::move(callback);
+		node.interval = intervalTicks;
+		node.domain = domain;
+
+		Wheel& wheel = wheels_[static_cast<std::size_t>(domain)];
+		node.due = wheel.currentTick + delayTicks;
+		Link(wheel, index);
+		++pendingCount_;
+
+		return TimerHandle{ (static_cast<uint64_t>(node.generation) << 32) | index };
+	}
+
+	Scheduler::TimerNode* Scheduler::Resolve(TimerHandle handle) const
+	{
+		const uint32_t index = static_cast<uint32_t>(handle.value);
+		const uint32_t generation = static_cast<uint32_t>(handle.value >> 32);
+		if (generation == 0 || index >= nodeCount_)
+			return nullptr;
+		TimerNode& node = Node(index);
+		return node.generation == generation && node.state != NodeState::Free ? &node : nullptr;
+	}
+
+	bool Scheduler::Cancel(TimerHandle handle)
+	{
+		TimerNode* node = Resolve(handle);
+		if (!node)
+			return false;
+
+		const uint32_t index = static_cast<uint32_t>(handle.value);
+		switch (node->state)
+		{
+		case NodeState::Pending:
+			Unlink(wheels_[static_cast<std::size_t>(node->domain)], index);
+			--pendingCount_;
+			FreeNode(index);
+			return true;
+		case NodeState::Expired:
+			// Ѿһ֡ĵбgeneration Ժᱻ
+			FreeNode(index);
+			return true;
+		case NodeState::Running:
+			// ִͷ
+			node->state = NodeState::Cancelled;
+			return node->interval != 0;
+		default:
+			return false;
+		}
+	}
+
+	bool Scheduler::IsPending(TimerHandle handle) const
+	{
+		const TimerNode* node = Resolve(handle);
+		return node && (node->state == NodeState::Pending || node->state == NodeState::Expired || (node->state == NodeState::Running && node->interval != 0));
+	}
+
+	double Scheduler::TimeRemaining(TimerHandle handle) const
+	{
+		const TimerNode* node = Resolve(handle);
+		if (!node || node->state != NodeState::Pending)
+			return IsPending(handle) ? 0.0 : -1.0;
+		const Wheel& wheel = wheels_[static_cast<std::size_t>(node->domain)];
+		const double remainingNs = static_cast<double>(node->due - wheel.currentTick) * kNanosecondsPerTick - static_cast<double>(wheel.elapsedNanoseconds % kNanosecondsPerTick);
+		return remainingNs * 1e-9;
+	}
+
+	void Scheduler::Advance(double realDeltaSeconds, double gameDeltaSeconds)
+	{
+		assert(!advancing_ && "Scheduler::Advance called from a timer callback");
+
+		const double deltas[] = { gameDeltaSeconds, realDeltaSeconds };
+		for (std::size_t i = 0; i < std::size(wheels_); ++i)
+		{
+			Wheel& wheel = wheels_[i];
+			wheel.elapsedNanoseconds += SecondsToNanoseconds(deltas[i]);
+			AdvanceWheel(wheel, wheel.elapsedNanoseconds / kNanosecondsPerTick);
+		}
+
+		if (!expired_.empty())
+			RunExpired();
+	}
+
+	void Scheduler::Clear()
+	{
+		for (uint32_t index = 0; index < nodeCount_; ++index)
+		{
+			TimerNode& node = Node(index);
+			if (node.state == NodeState::Pending || node.state == NodeState::Expired)
+				FreeNode(index);
+			else if (node.state == NodeState::Running)
+				node.state = NodeState::Cancelled;
+		}
+		for (Wheel& wheel : wheels_)
+		{
+			std::fill(std::begin(wheel.heads), std::end(wheel.heads), kNil);
+			std::memset(wheel.occupied, 0, sizeof(wheel.occupied));
+		}
+		pendingCount_ = 0;
+	}
+
+	uint32_t Scheduler::AllocateNode()
+	{
+		if (freeList_ != kNil)
+		{
+			const uint32_t index = freeList_;
+			freeList_ = Node(index).next;
+			return index;
+		}
+
+		if (nodeCount_ % kNodesPerChunk == 0)
+		{
+			chunks_.push_back(std::make_unique<TimerNode[]>(kNodesPerChunk));
+		}
+		return nodeCount_++;
+	}
+
+	void Scheduler::FreeNode(uint32_t index)
+	{
+		TimerNode& node = Node(index);
+		node.callback = nullptr;
+		node.state = NodeState::Free;
+		node.prev = kNil;
+		node.next = freeList_;
+		// generation 0 Ч
+		if (++node.generation == 0)
+			node.generation = 1;
+		freeList_ = index;
+	}
+
+	void Scheduler::Link(Wheel& wheel, uint32_t index)
+	{
+		TimerNode& node = Node(index);
+
+		// ʣʱѡ㣺 n һ۸ 256^n  tickΧȷ߲㣬תʱ·
+		uint64_t due = node.due;
+		uint64_t delta = due - wheel.currentTick;
+		uint32_t level = 0;
+		while (level + 1 < kLevels && delta >= (uint64_t{ 1 } << (kSlotBits * (level + 1))))
+		{
+			++level;
+		}
+		if (level == kLevels - 1 && delta >= (uint64_t{ 1 } << (kSlotBits * kLevels)))
+		{
+			due = wheel.currentTick + (uint64_t{ 1 } << (kSlotBits * kLevels)) - 1;
+		}
+		const uint32_t slot = static_cast<uint32_t>(due >> (kSlotBits * level)) & (kSlots - 1);
+		const uint32_t list = level * kSlots + slot;
+
+		node.slot = static_cast<uint16_t>(list);
+		node.state = NodeState::Pending;
+		node.prev = kNil;
+		node.next = wheel.heads[list];
+		if (node.next != kNil)
+			Node(node.next).prev = index;
+		wheel.heads[list] = index;
+		wheel.occupied[level][slot / 64] |= uint64_t{ 1 } << (slot % 64);
+	}
+
+	void Scheduler::Unlink(Wheel& wheel, uint32_t index)
+	{
+		TimerNode& node = Node(index);
+		if (node.prev != kNil)
+			Node(node.prev).next = node.next;
+		else
+			wheel.heads[node.slot] = node.next;
+		if (node.next != kNil)
+			Node(node.next).prev = node.prev;
+
+		if (wheel.heads[node.slot] == kNil)
+		{
+			const uint32_t level = node.slot / kSlots;
+			const uint32_t slot = node.slot % kSlots;
+			wheel.occupied[level][slot / 64] &= ~(uint64_t{ 1 } << (slot % 64));
+		}
+		node.prev = kNil;
+		node.next = kNil;
+	}
+
+	uint32_t Scheduler::DetachSlot(Wheel& wheel, uint32_t level, uint32_t slot)
+	{
+		const uint32_t list = level * kSlots + slot;
+		const uint32_t head = wheel.heads[list];
+		wheel.heads[list] = kNil;
+		wheel.occupied[level][slot / 64] &= ~(uint64_t{ 1 } << (slot % 64));
+		return head;
+	}
+
+	void Scheduler::AdvanceWheel(Wheel& wheel, uint64_t targetTick)
+	{
+		while (wheel.currentTick < targetTick)
+		{
+			const uint64_t next = wheel.currentTick + 1;
+			const uint32_t nextSlot = static_cast<uint32_t>(next) & (kSlots - 1);
+
+			if (nextSlot != 0)
+			{
+				// ڵ 0 һжʱĲۣмĿ tick ֱһȦͷ֮ǰûо
+				uint64_t found = 0;
+				for (uint32_t word = nextSlot / 64; word < kSlots / 64 && found == 0; ++word)
+				{
+					uint64_t bits = wheel.occupied[0][word];
+					if (word == nextSlot / 64)
+						bits &= ~uint64_t{ 0 } << (nextSlot % 64);
+					if (bits != 0)
+						found = (next & ~uint64_t{ kSlots - 1 }) + word * 64 + static_cast<uint32_t>(std::countr_zero(bits));
+				}
+				if (found == 0)
+				{
+					const uint64_t lastOfRound = next | (kSlots - 1);
+					wheel.currentTick = lastOfRound < targetTick ? lastOfRound : targetTick;
+					continue;
+				}
+				if (found > targetTick)
+				{
+					wheel.currentTick = targetTick;
+					break;
+				}
+				wheel.currentTick = found;
+			}
+			else
+			{
+				wheel.currentTick = next;
+
+				//  0 תһȦϲӦĲ·䵽²㣬߲
+				uint32_t levels = 1;
+				while (levels < kLevels && ((next >> (kSlotBits * levels)) & (kSlots - 1)) == 0)
+				{
+					++levels;
+				}
+				for (uint32_t level = (levels < kLevels ? levels : kLevels - 1); level >= 1; --level)
+				{
+					const uint32_t slot = static_cast<uint32_t>(next >> (kSlotBits * level)) & (kSlots - 1);
+					for (uint32_t index = DetachSlot(wheel, level, slot); index != kNil;)
+					{
+						const uint32_t following = Node(index).next;
+						Link(wheel, index);
+						index = following;
+					}
+				}
+			}
+
+			//  0 㵱ǰȫ
+			const uint32_t slot = static_cast<uint32_t>(wheel.currentTick) & (kSlots - 1);
+			for (uint32_t index = DetachSlot(wheel, 0, slot); index != kNil;)
+			{
+				TimerNode& node = Node(index);
+				const uint32_t following = node.next;
+				node.state = NodeState::Expired;
+				node.prev = kNil;
+				node.next = kNil;
+				expired_.push_back(ExpiredTimer{ index, node.generation });
+				--pendingCount_;
+				index = following;
+			}
+		}
+	}
+
+	void Scheduler::RunExpired()
+	{
+		advancing_ = true;
+
+		// صӵĶʱһ֡ڣ׷ӵ expired_
+		for (std::size_t i = 0; i < expired_.size(); ++i)
+		{
+			const ExpiredTimer expired = expired_[i];
+			TimerNode& node = Node(expired.index);
+			if (node.generation != expired.generation || node.state != NodeState::Expired)
+				continue;
+
+			// ڵ㰴䣬ַ䣬صӶʱҲ node ʧЧ
+			node.state = NodeState::Running;
+			node.callback();
+
+			if (node.interval != 0 && node.state == NodeState::Running)
+			{
+				// ظʱһ֡Ѿ
+				Wheel& wheel = wheels_[static_cast<std::size_t>(node.domain)];
+				const uint64_t missed = (wheel.currentTick - node.due) / node.interval;
+				node.due += (missed + 1) * node.interval;
+				Link(wheel, expired.index);
+				++pendingCount_;
+			}
+			else
+			{
+				FreeNode(expired.index);
+			}
+		}
+		expired_.clear();
+
+		advancing_ = false;
+	}
+}
@@ -0,0 +1,82 @@
+#include "pch.h"
+#include "Engine/Debug/StackTrace.h"
+
+#ifdef _WIN32
+#include <DbgHelp.h>
+#pragma comment(lib, "Dbghelp.lib")
+#else
+#include <execinfo.h>
+#endif
+
+namespace CBR::Engine::Debug
+{
+    uint16_t CaptureStack(void** frames, uint16_t maxDepth, uint32_t skip) noexcept
+    {
+        maxDepth = std::min<uint16_t>(maxDepth, static_cast<uint16_t>(kMaxStackDepth));
+#ifdef _WIN32
+        return static_cast<uint16_t>(CaptureStackBackTrace(static_cast<DWORD>(skip + 1), maxDepth, frames, nullptr));
+#else
+        void* buffer[kMaxStackDepth + 8];
+        const int wanted = static_cast<int>(std::min<std::size_t>(maxDepth + skip + 1, std::size(buffer)));
+        const int captured = ::backtrace(buffer, wanted);
+        const int first = static_cast<int>(skip + 1);
+        if (captured <= first)
+            return 0;
+
+        const uint16_t depth = static_cast<uint16_t>(std::min<int>(captured - first, maxDepth));
+        std::copy(buffer + first, buffer + first + depth, frames);
+        return depth;
+#endif
+    }
+
+
+    std::string DescribeFrame(void* frame)
+    {
+#ifdef _WIN32
+        // DbgHelp ̰߳ȫ
+        static std::mutex symbolMutex;
+        std::lock_guard<std::mutex> lk(symbolMutex);
+
+        static bool symbolsReady = false;
+        HANDLE process = GetCurrentProcess();
+        if (!symbolsReady)
+        {
+            SymSetOptions(SymGetOptions() | SYMOPT_LOAD_LINES | SYMOPT_UNDNAME);
+            symbolsReady = SymInitialize(process, nullptr, TRUE) != FALSE;
+        }
+
+        const DWORD64 address = reinterpret_cast<DWORD64>(frame);
+        char buffer[sizeof(SYMBOL_INFO) + 256] = {};
+        SYMBOL_INFO* symbol = reinterpret_cast<SYMBOL_INFO*>(buffer);
+        symbol->SizeOfStruct = sizeof(SYMBOL_INFO);
+        symbol->MaxNameLen = 255;
+
+        std::string text;
+        DWORD64 displacement = 0;
+        if (symbolsReady && SymFromAddr(process, address, &displacement, symbol))
+            text = std::format("{}+0x{:X}", symbol->Name, displacement);
+        else if (const DWORD64 base = symbolsReady ? SymGetModuleBase64(process, address) : 0; base != 0)
+            text = std::format("<module>+0x{:X}", address - base);
+        else
+            text = "<unknown>";
+
+        IMAGEHLP_LINE64 line{};
+        line.SizeOfStruct = sizeof(line);
+        DWORD lineDisplacement = 0;
+        if (symbolsReady && SymGetLineFromAddr64(process, address, &lineDisplacement, &line))
+            text += std::format(" ({}:{})", line.FileName, line.LineNumber);
+        return text;
+#else
+        char** symbols = ::backtrace_symbols(&frame, 1);
+        if (!symbols)
+            return "<unknown>";
+
+        // "binary(func+0x12) [0x7f...]"ȥľԵַ
+        std::string text = symbols[0];
+        std::free(symbols);
+        if (const std::size_t bracket = text.rfind(" ["); bracket != std::string::npos)
+            text.resize(bracket);
+        return text;
+#endif
+    }
+} // namespace CBR::Engine::Debug
@@ -1,17 +1,12 @@
 #include "pch.h"
 #include "Engine/Utility/Timer.h"
+#include "Engine/Utility/Clock.h"
 
 namespace CBR::Engine::Utility
 {
 	Timer::Timer()
 	{
-		LARGE_INTEGER freq;
-		QueryPerformanceFrequency(&freq);
-		frequency_ = freq.QuadPart;
-
-		LARGE_INTEGER now;
-		QueryPerformanceCounter(&now);
-		engineStartCounter_ = now.QuadPart;
+		engineStartCounter_ = Clock::Now();
 		lastFrameCounter_ = engineStartCounter_; // һ֡dt
 	}
 
@@ -22,16 +17,58 @@ namespace CBR::Engine::Utility
 
 	void Timer::Tick()
 	{
-		LARGE_INTEGER now;
-		QueryPerformanceCounter(&now);
+		const uint64_t now = Clock::Now();
 
-		int64_t deltaCounts = now.QuadPart - lastFrameCounter_;
-		lastFrameCounter_ = now.QuadPart;
+		const uint64_t deltaCounts = now - lastFrameCounter_;
+		lastFrameCounter_ = now;
 
-		rawDeltaTime_ = double(deltaCounts) / double(frequency_);
+		rawDeltaTime_ = Clock::ToSeconds(deltaCounts);
 		rawTotalTime_ += rawDeltaTime_;
 		deltaTime_ = rawDeltaTime_ * timeScale_;
 		totalTime_ += deltaTime_;
 		++frameIndex_;
+		frameStats_.Record(frameIndex_, rawTotalTime_, rawDeltaTime_);
+
+		// ̶ۼ֡ MAX_FRAME_DELTA_TIME׷ϵĲҲ
+		double frameTime = deltaTime_;
+		if (frameTime > MAX_FRAME_DELTA_TIME)
+		{
+			droppedTime_ += frameTime - MAX_FRAME_DELTA_TIME;
+			frameTime = MAX_FRAME_DELTA_TIME;
+		}
+		timeLag_ += frameTime;
+
+		fixedStepCount_ = 0;
+		while (timeLag_ >= fixedDeltaTime_ && fixedStepCount_ < maxFixedStepsPerFrame_)
+		{
+			timeLag_ -= fixedDeltaTime_;
+			++fixedStepCount_;
+		}
+		fixedStepIndex_ += fixedStepCount_;
+
+		// ﵽ޻ʣʱ˵ģϣĲֻ֣һ
+		if (timeLag_ >= fixedDeltaTime_)
+		{
+			const double remainder = std::fmod(timeLag_, fixedDeltaTime_);
+			droppedTime_ += timeLag_ - remainder;
+			timeLag_ = remainder;
+		}
+	}
+
+	void Timer::Resume()
+	{
+		lastFrameCounter_ = Clock::Now();
+	}
+
+	void Timer::SetFixedStepRate(double stepsPerSecond)
+	{
+		assert(stepsPerSecond > 0.0);
+		if (!(stepsPerSecond > 0.0))
+			return;
+
+		// ֲֵ䣬лʱ治
+		const double alpha = InterpolationAlpha();
+		fixedDeltaTime_ = 1.0 / stepsPerSecond;
+		timeLag_ = alpha * fixedDeltaTime_;
 	}
 }
@@ -2,6 +2,11 @@
 #include "Engine/WindowsMain.h"
 #include "Engine/GameEngine.h"
 #include "Engine/Debug/Logger.h"
+#include "Engine/Memory/NoAllocScope.h"
+#include "Engine/Utility/Clock.h"
+#include "Engine/Utility/FramePacer.h"
+#include "Engine/Utility/Timer.h"
+#include "Engine/Utility/Environment.h"
 
 constexpr uint32_t DefaultScreenWidth = 800;
 constexpr uint32_t DefaultScreenHeight = 600;
@@ -21,8 +26,48 @@ struct
 	const wchar_t* applicationName = NULL;
 	const wchar_t* className = NULL;
 	std::unordered_set<CBR::Engine::WindowsMain::WinProcDelegate> eventOnWndProc;
+	CBR::Engine::WindowsMain::BackgroundPolicy backgroundPolicy;
+	CBR::Engine::WindowsMain::MainLoopStats loopStats;
 } state;
 
+using LoopMode = CBR::Engine::WindowsMain::LoopMode;
+
+// ̵û̬+ں̬ CPU ʱ䣨룩
+static double ProcessCpuSeconds()
+{
+	FILETIME creation, exit, kernel, user;
+	if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+		return 0.0;
+	auto toTicks = [](const FILETIME& time) { return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime; };
+	return static_cast<double>(toTicks(kernel) + toTicks(user)) * 1e-7; // 100ns
+}
+
+static LoopMode CurrentLoopMode()
+{
+	if (state.bMinimized || state.bResizing || !IsWindowVisible(state.hWnd))
+		return LoopMode::Hidden;
+	if (!state.bActivated)
+		return LoopMode::Unfocused;
+	return LoopMode::Foreground;
+}
+
+// ϴлʱǵ mode 
+struct LoopModeClock
+{
+	uint64_t since = CBR::Engine::Utility::Clock::Now();
+	double cpuSince = ProcessCpuSeconds();
+
+	void Charge(LoopMode mode)
+	{
+		const uint64_t now = CBR::Engine::Utility::Clock::Now();
+		const double cpu = ProcessCpuSeconds();
+		state.loopStats.wallSeconds[static_cast<std::size_t>(mode)] += CBR::Engine::Utility::Clock::ToSeconds(now - since);
+		state.loopStats.cpuSeconds[static_cast<std::size_t>(mode)] += cpu - cpuSince;
+		since = now;
+		cpuSince = cpu;
+	}
+};
+
 namespace CBR::Engine
 {
 	void WindowsMain::RegisterWndProc(WinProcDelegate pDelegate)
@@ -42,7 +87,7 @@ namespace CBR::Engine
 		{
 			LRESULT result = delegate(hWnd, uMsg, wParam, lParam);
 			if (FAILED(result))
-				LOG_ERROR("WindowProc delegate returned an error: 0x{:X}", result);
+				LOG_ERROR("WindowProc delegate returned an error: 0x{:X}", static_cast<uint64_t>(result));
 				DebugBreak();
 		}
 		
@@ -153,6 +198,16 @@ namespace CBR::Engine
 			return 0;
 		}
 
+		if (const std::string fps = Utility::ReadEnvironmentVariable("CBR_UNFOCUSED_FPS"); !fps.empty())
+			state.backgroundPolicy.unfocusedFrameRate = std::strtod(fps.c_str(), nullptr);
+		if (const std::string rate = Utility::ReadEnvironmentVariable("CBR_HIDDEN_TICK_RATE"); !rate.empty())
+			state.backgroundPolicy.hiddenTickRate = std::strtod(rate.c_str(), nullptr);
+
+		Utility::FramePacer& pacer = GameEngine::GetFramePacer();
+		double foregroundFrameRate = pacer.TargetFrameRate();
+		LoopMode mode = LoopMode::Foreground;
+		LoopModeClock modeClock;
+
 		MSG msg = {};
 		while (msg.message != WM_QUIT)
 		{
@@ -169,21 +224,63 @@ namespace CBR::Engine
 				DispatchMessage(&msg);
 			}
 			// ֻϢбΪʱִϷѭ
-			else if (!state.bResizing && !state.bMinimized && /*state.bActivated*/IsWindowVisible(state.hWnd)) 
+			else
 			{
-				if (!GameEngine::Iteration())
+				// ǰ̨/̨лʱ֡ޣʧȥ㽵 unfocusedFrameRateСʱ hiddenTickRate ֻģ
+				if (const LoopMode current = CurrentLoopMode(); current != mode)
+				{
+					modeClock.Charge(mode);
+					if (mode == LoopMode::Foreground)
+						foregroundFrameRate = pacer.TargetFrameRate();
+
+					double targetFrameRate = foregroundFrameRate;
+					if (current == LoopMode::Unfocused && state.backgroundPolicy.unfocusedFrameRate > 0.0)
+						targetFrameRate = state.backgroundPolicy.unfocusedFrameRate;
+					else if (current == LoopMode::Hidden)
+						targetFrameRate = state.backgroundPolicy.hiddenTickRate;
+					pacer.SetTargetFrameRate(targetFrameRate);
+					mode = current;
+				}
+
+				if (mode == LoopMode::Hidden && state.backgroundPolicy.hiddenTickRate <= 0.0)
+				{
+					// ģʱһϢָڡرյȣռ CPU
+					WaitMessage();
+					// ʱ䲻һ֡
+					GameEngine::GetTimer().Resume();
+					continue;
+				}
+
+				if (!GameEngine::Iteration(mode != LoopMode::Hidden))
 				{
 					break;
 				}
+				++state.loopStats.iterations[static_cast<std::size_t>(mode)];
 			}
 		}
 
+		modeClock.Charge(mode);
+		constexpr const char* kLoopModeNames[] = { "foreground", "unfocused", "hidden" };
+		for (std::size_t i = 0; i < static_cast<std::size_t>(LoopMode::Count); ++i)
+		{
+			const double wall = state.loopStats.wallSeconds[i];
+			if (wall <= 0.0)
+				continue;
+			CBR_LOG(Engine, Info, "Main loop {}: {:.1f} s, {} frames, CPU {:.1f}%.", kLoopModeNames[i], wall, state.loopStats.iterations[i], 100.0 * state.loopStats.cpuSeconds[i] / wall);
+		}
+
 		GameEngine::Shutdown();
 
 		UnregisterClass(state.className, state.hInstance);
 
 		// ó˳PostQuitMessageⲿ
-		return static_cast<int>(msg.wParam);
+		int exitCode = static_cast<int>(msg.wParam);
+		// ϸģʽ֡жѷʱط 0CI ݴжʧ
+		if (exitCode == 0 && Memory::GetNoAllocMode() == Memory::NoAllocMode::Strict && Memory::GetNoAllocViolationCount() != 0)
+		{
+			exitCode = 3;
+		}
+		return exitCode;
 	}
 
 	HRESULT WindowsMain::InitWindow(HINSTANCE hInstance, int nCmdShow)
@@ -256,6 +353,21 @@ namespace CBR::Engine
 		return S_OK;
 	}
 
+	void WindowsMain::SetBackgroundPolicy(const BackgroundPolicy& policy)
+	{
+		state.backgroundPolicy = policy;
+	}
+
+	const WindowsMain::BackgroundPolicy& WindowsMain::GetBackgroundPolicy()
+	{
+		return state.backgroundPolicy;
+	}
+
+	WindowsMain::MainLoopStats WindowsMain::GetMainLoopStats()
+	{
+		return state.loopStats;
+	}
+
 	HWND WindowsMain::GetMainWindowHandle()
 	{
 		return state.hWnd;
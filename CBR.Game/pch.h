@@ -4,6 +4,7 @@
 #include <iostream>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <cassert>
 #include <Windows.h>
 #include <string_view>
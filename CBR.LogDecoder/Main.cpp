@@ -0,0 +1,203 @@
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Engine/Debug/LogBinaryFormat.h"
+
+//  Logger Ķ־CBR_LOG_BINARYм¼ı dump ԭɺͿ̨һıʽ
+// ÷: CBR.LogDecoder <input.cbrlog> [output.txt]
+
+using namespace CBR::Engine::Debug;
+
+namespace
+{
+    struct SiteDefinition
+    {
+        uint8_t level = 0;
+        uint32_t line = 0;
+        std::string file;
+        std::string func;
+        std::string format;
+    };
+
+    const char* LevelToString(uint8_t level)
+    {
+        //  LogLevel::Value ˳һ
+        switch (level)
+        {
+        case 0: return "INFO";
+        case 1: return "WARN";
+        case 2: return "ERROR";
+        case 3: return "DEBUG";
+        }
+        return "UNKNOWN";
+    }
+
+    std::string FormatTimestamp(int64_t nanoseconds)
+    {
+        const std::time_t seconds = static_cast<std::time_t>(nanoseconds / 1000000000);
+        const int milliseconds = static_cast<int>((nanoseconds / 1000000) % 1000);
+
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &seconds);
+#else
+        localtime_r(&seconds, &tm);
+#endif
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d.%03d", tm.tm_hour, tm.tm_min, tm.tm_sec, milliseconds);
+        return buffer;
+    }
+
+    //  Logger::WriteRecord ͬĲ: [#seq] [timestamp] [LEVEL] [file:line | func]ûļʱʡλ
+    void WriteHeader(std::ostream& out, uint16_t sequence, int64_t timestamp, uint8_t level, std::string_view file, uint32_t line, std::string_view func)
+    {
+        out << "[#" << sequence << "] [" << FormatTimestamp(timestamp) << "] [" << LevelToString(level) << "] ";
+        if (level == 0 || level == 1)
+            out << ' ';
+
+        if (!file.empty())
+        {
+            const std::size_t pos = file.find_last_of("/\\");
+            const std::string_view fname = (pos == std::string_view::npos) ? file : file.substr(pos + 1);
+            out << '[' << fname << ':' << line << " | " << func << ']';
+        }
+        out << '\n';
+    }
+
+    template<typename T>
+    bool Read(std::istream& in, T& value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+    }
+
+    bool ReadString(std::istream& in, std::string& out, std::size_t length)
+    {
+        out.resize(length);
+        return length == 0 || static_cast<bool>(in.read(out.data(), length));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: CBR.LogDecoder <input.cbrlog> [output.txt]\n";
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "Failed to open " << argv[1] << '\n';
+        return 1;
+    }
+
+    std::ofstream file;
+    if (argc >= 3)
+    {
+        file.open(argv[2]);
+        if (!file)
+        {
+            std::cerr << "Failed to open " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    std::ostream& out = file.is_open() ? static_cast<std::ostream&>(file) : std::cout;
+
+    LogBinary::FileHeader header{};
+    if (!Read(in, header) || std::memcmp(header.magic, LogBinary::kMagic, sizeof(header.magic)) != 0)
+    {
+        std::cerr << "Not a CBR binary log\n";
+        return 1;
+    }
+    if (header.version < 2 || header.version > LogBinary::kVersion)
+    {
+        std::cerr << "Unsupported binary log version " << header.version << '\n';
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, SiteDefinition> sites;
+    std::vector<char> payload;
+    std::size_t eventCount = 0;
+
+    LogBinary::ChunkType type{};
+    while (Read(in, type))
+    {
+        if (type == LogBinary::ChunkType::SiteDefinition)
+        {
+            uint32_t id = 0;
+            uint16_t fileLength = 0, funcLength = 0, formatLength = 0;
+            SiteDefinition site;
+            if (!Read(in, id) || !Read(in, site.level) || !Read(in, site.line) || !Read(in, fileLength) || !Read(in, funcLength) || !Read(in, formatLength)
+                || !ReadString(in, site.file, fileLength) || !ReadString(in, site.func, funcLength) || !ReadString(in, site.format, formatLength))
+                break;
+
+            sites[id] = std::move(site);
+        }
+        else if (type == LogBinary::ChunkType::Event)
+        {
+            uint32_t siteId = 0;
+            uint16_t sequence = 0;
+            int64_t timestamp = 0;
+            uint16_t payloadLength = 0;
+            if (!Read(in, siteId) || !Read(in, sequence) || !Read(in, timestamp) || !Read(in, payloadLength))
+                break;
+
+            payload.resize(payloadLength);
+            if (payloadLength && !in.read(payload.data(), payloadLength))
+                break;
+
+            const auto it = sites.find(siteId);
+            if (it == sites.end())
+            {
+                std::cerr << "Event #" << sequence << " references unknown site " << siteId << '\n';
+                continue;
+            }
+            const SiteDefinition& site = it->second;
+
+            WriteHeader(out, sequence, timestamp, site.level, site.file, site.line, site.func);
+            out << LogBinary::FormatPayload(site.format, payload.data(), payload.size()) << "\n\n";
+            ++eventCount;
+        }
+        else if (type == LogBinary::ChunkType::Message)
+        {
+            // ûеõı¼ظ/ʾȣ
+            uint8_t level = 0;
+            uint16_t sequence = 0;
+            int64_t timestamp = 0;
+            uint32_t line = 0;
+            uint16_t fileLength = 0, funcLength = 0, textLength = 0;
+            std::string messageFile, func, text;
+            if (!Read(in, level) || !Read(in, sequence) || !Read(in, timestamp) || !Read(in, line) || !Read(in, fileLength) || !Read(in, funcLength) || !Read(in, textLength)
+                || !ReadString(in, messageFile, fileLength) || !ReadString(in, func, funcLength) || !ReadString(in, text, textLength))
+                break;
+
+            WriteHeader(out, sequence, timestamp, level, messageFile, line, func);
+            out << text << "\n\n";
+            ++eventCount;
+        }
+        else if (type == LogBinary::ChunkType::Thread)
+        {
+            // м¼ dump֮ļ¼߳
+            uint32_t threadId = 0;
+            if (!Read(in, threadId))
+                break;
+
+            out << "---- thread " << threadId << " ----\n\n";
+        }
+        else
+        {
+            std::cerr << "Corrupt chunk type " << static_cast<int>(type) << ", stopping\n";
+            break;
+        }
+    }
+
+    std::cerr << "Decoded " << eventCount << " records from " << sites.size() << " call sites\n";
+    return 0;
+}